@@ -5,7 +5,8 @@
  * Architecture:
  * - BSP handles display hardware (for boards with BSP components)
  * - Direct esp_lcd init for boards without BSP (e.g., esp32_s3_box)
- * - rcore callback interface connects raylib to display
+ * - raylib owns the present path: flip, byte swap and pooled DMA chunk transfers
+ *   run inside the component (raylib_esp_set_panel)
  * - No separate port layer needed
  *
  * Board configurations sourced from esp-bsp JSON files:
@@ -19,6 +20,7 @@
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
 #include "raylib.h"
+#include "raylib_esp.h"
 
 static const char *TAG = "ESP_VOCAT";
 
@@ -26,48 +28,6 @@ static const char *TAG = "ESP_VOCAT";
 static esp_lcd_panel_handle_t g_panel = NULL;
 static esp_lcd_panel_io_handle_t g_io = NULL;
 
-// Chunk size: 48 lines (matches BSP max_transfer_sz)
-#define CHUNK_LINES 48
-
-/**
- * @brief Display flush callback for rcore - chunks framebuffer
- */
-static void display_flush(const uint16_t *buf, uint16_t x, uint16_t y, uint16_t w, uint16_t h)
-{
-    if (!g_panel || !buf) {
-        return;
-    }
-
-    // Flush in chunks (48 lines max) to match BSP max_transfer_sz
-    for (uint16_t row = 0; row < h; row += CHUNK_LINES) {
-        uint16_t chunk_height = (row + CHUNK_LINES > h) ? (h - row) : CHUNK_LINES;
-        const uint16_t *chunk_pixels = buf + (row * w);
-
-        // Swap bytes for RGB565 (little-endian ESP32 to big-endian SPI LCD)
-        // Allocate temporary buffer for swapped bytes
-        uint16_t *swapped_buf = heap_caps_malloc(chunk_height * w * sizeof(uint16_t), MALLOC_CAP_DMA);
-        if (!swapped_buf) {
-            ESP_LOGE(TAG, "Failed to allocate swap buffer");
-            return;
-        }
-        for (int i = 0; i < chunk_height * w; i++) {
-            swapped_buf[i] = __builtin_bswap16(chunk_pixels[i]);
-        }
-
-        esp_err_t ret = esp_lcd_panel_draw_bitmap(
-            g_panel,
-            x, y + row, x + w, y + row + chunk_height,
-            swapped_buf
-        );
-        heap_caps_free(swapped_buf);
-
-        if (ret != ESP_OK) {
-            ESP_LOGE(TAG, "Failed to draw bitmap chunk at row %d: %s", row, esp_err_to_name(ret));
-            return;
-        }
-    }
-}
-
 /**
  * @brief Get display dimensions callback
  * Source: esp-bsp/bsp/<board>/<board>.json -> BSP_LCD_H_RES, BSP_LCD_V_RES
@@ -78,12 +38,6 @@ static void display_get_dimensions(uint16_t *w, uint16_t *h)
     if (h) *h = 360;
 }
 
-// External rcore callback
-extern void raylib_esp_set_display_callbacks(
-    void (*flush_fn)(const uint16_t *buf, uint16_t x, uint16_t y, uint16_t w, uint16_t h),
-    void (*get_dim_fn)(uint16_t *w, uint16_t *h)
-);
-
 #define RAYLIB_TASK_STACK_SIZE (128 * 1024)
 
 /**
@@ -93,10 +47,14 @@ static esp_err_t init_display(void)
 {
     ESP_LOGI(TAG, "Initializing display...");
 
+    // raylib present stage: ring of DMA bounce buffers sized to max_transfer_sz
+    raylib_esp_panel_config_t present_cfg = RAYLIB_ESP_PANEL_CONFIG_DEFAULT();
+
     bsp_display_config_t cfg = {
         .max_transfer_sz = 320 * 48 * sizeof(uint16_t),  // 48-line chunks
     };
     esp_err_t ret = bsp_display_new(&cfg, &g_panel, &g_io);
+    present_cfg.max_transfer_sz = cfg.max_transfer_sz;
     if (ret != ESP_OK) {
         ESP_LOGE(TAG, "BSP display init failed: %s", esp_err_to_name(ret));
         return ret;
@@ -107,8 +65,9 @@ static esp_err_t init_display(void)
     // Small delay for display to stabilize
     vTaskDelay(pdMS_TO_TICKS(100));
 
-    // Register display callbacks with rcore
-    raylib_esp_set_display_callbacks(display_flush, display_get_dimensions);
+    // Hand the panel to raylib (the component registers on_color_trans_done on the IO)
+    ESP_ERROR_CHECK(raylib_esp_set_panel(g_panel, g_io, &present_cfg));
+    raylib_esp_set_display_callbacks(NULL, display_get_dimensions);
 
     uint16_t w, h;
     display_get_dimensions(&w, &h);
@@ -145,7 +104,8 @@ void raylib_task(void *pvParameter)
     EndDrawing();
     vTaskDelay(pdMS_TO_TICKS(1000));
 
-    // Main loop
+    // Main loop, paced to 60 FPS (EndDrawing() sleeps out the rest of each frame)
+    SetTargetFPS(60);
     int frame = 0;
     while (!WindowShouldClose()) {
         BeginDrawing();
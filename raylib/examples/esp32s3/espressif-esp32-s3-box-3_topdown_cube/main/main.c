@@ -0,0 +1,163 @@
+/**
+ * @file main.c
+ * @brief Raylib top-down 3D example
+ *
+ * Draws a back-face culled cube with the top_down present option enabled: the screen and camera
+ * projections are flipped so rlsw rows land in display order, which reverses the winding.
+ * Expected picture: a 2D title upright at the top left and a cube seen from above, showing
+ * its yellow top, red front and green right faces. Upside-down output, or the dark gray
+ * bottom/back/left faces showing, means the flip or the cull face is wrong
+ *
+ * Architecture:
+ * - BSP handles display hardware (for boards with BSP components)
+ * - Direct esp_lcd init for boards without BSP (e.g., esp32_s3_box)
+ * - raylib owns the present path: flip, byte swap and pooled DMA chunk transfers
+ *   run inside the component (raylib_esp_set_panel)
+ * - No separate port layer needed
+ *
+ * Board configurations sourced from esp-bsp JSON files:
+ * /path/to/esp-bsp/bsp/<board_name>/<board_name>.json
+ */
+
+#include "bsp/esp-bsp.h"
+#include "esp_log.h"
+#include "esp_err.h"
+#include "esp_lcd_panel_ops.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "raylib.h"
+#include "rlgl.h"
+#include "raylib_esp.h"
+
+static const char *TAG = "ESP32S3_BOX_3_TOPDOWN";
+
+// Display handles from BSP
+static esp_lcd_panel_handle_t g_panel = NULL;
+static esp_lcd_panel_io_handle_t g_io = NULL;
+
+/**
+ * @brief Get display dimensions callback
+ * Source: esp-bsp/bsp/<board>/<board>.json -> BSP_LCD_H_RES, BSP_LCD_V_RES
+ */
+static void display_get_dimensions(uint16_t *w, uint16_t *h)
+{
+    if (w) *w = 320;
+    if (h) *h = 240;
+}
+
+#define RAYLIB_TASK_STACK_SIZE (128 * 1024)
+
+/**
+ * @brief Initialize display using BSP (or direct esp_lcd for esp32_s3_box)
+ */
+static esp_err_t init_display(void)
+{
+    ESP_LOGI(TAG, "Initializing display...");
+
+    // raylib present stage: ring of DMA bounce buffers sized to max_transfer_sz
+    raylib_esp_panel_config_t present_cfg = RAYLIB_ESP_PANEL_CONFIG_DEFAULT();
+
+    bsp_display_config_t cfg = {
+        .max_transfer_sz = 320 * 48 * sizeof(uint16_t),  // 48-line chunks
+    };
+    esp_err_t ret = bsp_display_new(&cfg, &g_panel, &g_io);
+    present_cfg.max_transfer_sz = cfg.max_transfer_sz;
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "BSP display init failed: %s", esp_err_to_name(ret));
+        return ret;
+    }
+    esp_lcd_panel_disp_on_off(g_panel, true);
+    bsp_display_backlight_on();
+
+    // Small delay for display to stabilize
+    vTaskDelay(pdMS_TO_TICKS(100));
+
+    // Hand the panel to raylib (the component registers on_color_trans_done on the IO)
+    ESP_ERROR_CHECK(raylib_esp_set_panel(g_panel, g_io, &present_cfg));
+    raylib_esp_set_display_callbacks(NULL, display_get_dimensions);
+
+    uint16_t w, h;
+    display_get_dimensions(&w, &h);
+    ESP_LOGI(TAG, "Display initialized: %dx%d", w, h);
+    return ESP_OK;
+}
+
+/**
+ * @brief Unit cube with one color per face, counter-clockwise seen from outside
+ */
+static void draw_face_cube(void)
+{
+    rlBegin(RL_QUADS);
+
+    // +Z front
+    rlColor4ub(RED.r, RED.g, RED.b, RED.a);
+    rlVertex3f(-1, -1, 1); rlVertex3f(1, -1, 1); rlVertex3f(1, 1, 1); rlVertex3f(-1, 1, 1);
+
+    // +Y top
+    rlColor4ub(YELLOW.r, YELLOW.g, YELLOW.b, YELLOW.a);
+    rlVertex3f(-1, 1, 1); rlVertex3f(1, 1, 1); rlVertex3f(1, 1, -1); rlVertex3f(-1, 1, -1);
+
+    // +X right
+    rlColor4ub(GREEN.r, GREEN.g, GREEN.b, GREEN.a);
+    rlVertex3f(1, -1, 1); rlVertex3f(1, -1, -1); rlVertex3f(1, 1, -1); rlVertex3f(1, 1, 1);
+
+    // Faces turned away from the camera, culled when the winding is handled right
+    rlColor4ub(DARKGRAY.r, DARKGRAY.g, DARKGRAY.b, DARKGRAY.a);
+    rlVertex3f(1, -1, -1); rlVertex3f(-1, -1, -1); rlVertex3f(-1, 1, -1); rlVertex3f(1, 1, -1);
+    rlVertex3f(-1, -1, -1); rlVertex3f(1, -1, -1); rlVertex3f(1, -1, 1); rlVertex3f(-1, -1, 1);
+    rlVertex3f(-1, -1, -1); rlVertex3f(-1, -1, 1); rlVertex3f(-1, 1, 1); rlVertex3f(-1, 1, -1);
+
+    rlEnd();
+}
+
+void raylib_task(void *pvParameter)
+{
+    ESP_LOGI(TAG, "Initializing Raylib...");
+
+    // Render in display row order, no flip at present time
+    raylib_esp_present_config_t present = RAYLIB_ESP_PRESENT_CONFIG_DEFAULT();
+    present.top_down = true;
+    raylib_esp_set_present_config(&present);
+
+    uint16_t w, h;
+    display_get_dimensions(&w, &h);
+    InitWindow(w, h, "ESP32-S3-BOX-3 Top-down Cube");
+
+    Camera3D camera = {
+        .position = { 3.0f, 3.0f, 3.0f },
+        .target = { 0.0f, 0.0f, 0.0f },
+        .up = { 0.0f, 1.0f, 0.0f },
+        .fovy = 45.0f,
+        .projection = CAMERA_PERSPECTIVE,
+    };
+
+    ESP_LOGI(TAG, "Starting demo loop...");
+
+    // Main loop, paced to 30 FPS (EndDrawing() sleeps out the rest of each frame)
+    SetTargetFPS(30);
+    while (!WindowShouldClose()) {
+        BeginDrawing();
+        ClearBackground(SKYBLUE);
+
+        BeginMode3D(camera);
+        draw_face_cube();
+        EndMode3D();
+
+        DrawText("top_down 3D", 10, 10, 20, BLACK);
+        DrawRectangle(0, h - 20, 20, 20, PURPLE);
+
+        EndDrawing();
+    }
+
+    CloseWindow();
+    vTaskDelete(NULL);
+}
+
+void app_main(void)
+{
+    ESP_LOGI(TAG, "Raylib Demo");
+
+    ESP_ERROR_CHECK(init_display());
+
+    xTaskCreatePinnedToCore(raylib_task, "raylib", RAYLIB_TASK_STACK_SIZE, NULL, 5, NULL, 1);
+}
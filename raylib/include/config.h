@@ -19,8 +19,11 @@
 
 // Define software renderer memory allocators BEFORE raylib's rlgl.h tries to define them
 // These macros will be used by the software renderer (rlsw.h)
-#define SW_MALLOC(sz) heap_caps_malloc(sz, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT)
-#define SW_REALLOC(ptr, newSz) heap_caps_realloc(ptr, newSz, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT)
+// PSRAM by default, internal RAM preferred for band-sized buffers (band render mode, rcore_esp_idf.c)
+// and for hot textures (texture residency, rtexture_esp_idf.c)
+uint32_t EspSwMallocCaps(void);
+#define SW_MALLOC(sz) heap_caps_malloc_prefer(sz, 2, EspSwMallocCaps(), MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT)
+#define SW_REALLOC(ptr, newSz) heap_caps_realloc_prefer(ptr, newSz, 2, EspSwMallocCaps(), MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT)
 #define SW_FREE(ptr) heap_caps_free(ptr)
 
 //------------------------------------------------------------------------------------
@@ -137,4 +140,54 @@
 #define MAX_TEXT_BUFFER_LENGTH        512       // Reduced for embedded
 #define MAX_TEXTSPLIT_COUNT            64       // Reduced for embedded
 
+//------------------------------------------------------------------------------------
+// Module: rcore_esp_idf - Configuration Flags
+//------------------------------------------------------------------------------------
+#define SUPPORT_ESP_ASYNC_PRESENT       1       // Async present on a dedicated flush task (enabled at runtime)
+#define SUPPORT_ESP_DAMAGE_TRACKING     1       // Dirty rectangle present mode (enabled at runtime)
+#define SUPPORT_ESP_TILE_DIFF           1       // Tile checksum frame differencing present mode (enabled at runtime)
+// The PIE kernels stay off until checked on an ESP32-S3 with test/target, which builds them
+// with -DSUPPORT_ESP_PIE_KERNELS=1
+#ifndef SUPPORT_ESP_PIE_KERNELS
+#define SUPPORT_ESP_PIE_KERNELS         0       // ESP32-S3 PIE SIMD pixel kernels (portable fallback on other targets)
+#endif
+#define SUPPORT_ESP_BAND_RENDER         1       // Band render mode, no full-frame rlsw buffers (enabled at runtime)
+#define SUPPORT_ESP_RGB_PANEL           1       // Present into esp_lcd RGB panel frame buffers (enabled at runtime, RGB LCD targets)
+#define SUPPORT_ESP_FAST_RECT           1       // Fill screen-aligned solid rectangles and clears with span writes
+#define SUPPORT_ESP_FAST_RECT_BENCHMARK 0       // Log general vs fast rectangle timings at the first BeginDrawing()
+#define SUPPORT_ESP_FAST_BLIT           1       // Copy unscaled, integer-aligned texture draws from RGB565 texture shadows
+#define SUPPORT_ESP_NATIVE_TEXTURES     1       // Store RGB(A) 24/32-bit textures as RGB565/RGBA5551/RGBA4444 in rlsw
+#define SUPPORT_ESP_TEXTURE_RESIDENCY   1       // Move frequently drawn small textures into internal RAM
+#define SUPPORT_ESP_GLYPH_CACHE         1       // Draw DrawText()/DrawTextEx() glyphs from cached pre-scaled alpha masks
+// The 2D-only profile saves clear time, not memory: rlsw still allocates its 16-bit depth buffer
+// (width x height x 2 bytes), only band mode shrinks it to one band
+#define SUPPORT_ESP_2D_ONLY             0       // 2D-only profile: screen clears skip the depth buffer, depth testing stays off
+#define SUPPORT_ESP_PROFILER            0       // Time frame phases into a ring buffer (raylib_esp_get_frame_stats())
+#define SUPPORT_ESP_TRACE               0       // Trace events: SystemView (CONFIG_APPTRACE_SV_ENABLE) or Chrome trace JSON
+#define SUPPORT_ESP_RENDER_STATS        0       // Count primitives, triangles, fragments and texture switches, overdraw heatmap
+
+//------------------------------------------------------------------------------------
+// rcore_esp_idf: Configuration values
+//------------------------------------------------------------------------------------
+#define ESP_PRESENT_MAX_QUEUE_DEPTH     4       // Upper bound for present buffers in async mode
+#define ESP_DAMAGE_MAX_RECTS            8       // Dirty rectangles kept per frame before merging
+#define ESP_DAMAGE_MERGE_WASTE       1024       // Merge two rectangles if their union adds fewer pixels than this
+#define ESP_DAMAGE_FULL_PERCENT        75       // Flush the full screen once damage exceeds this share
+#define ESP_TILE_WIDTH                 32       // Tile size for frame differencing (width must be even)
+#define ESP_TILE_HEIGHT                16
+#define ESP_PANEL_MAX_BOUNCE_BUFFERS    3       // Upper bound for DMA bounce buffers of the panel present stage
+#define ESP_PANEL_MAX_RGB_FRAME_BUFFERS 3       // esp_lcd RGB panels allocate at most 3 frame buffers
+#define ESP_LIST_INITIAL_OPS         1024       // Initial display list capacity (grows in PSRAM)
+#define ESP_BLIT_MAX_TEXTURES          32       // Textures classified for the fast paths (shadowed when enabled at upload)
+#define ESP_BLIT_MAX_TEXTURE_PIXELS 65536       // Larger textures are drawn through rlsw only
+#define ESP_TEXTURE_MAX_NATIVE         64       // Converted textures tracked for updates (further uploads stay unconverted)
+#define ESP_TEXTURE_RESIDENCY_BUDGET 65536      // Default internal RAM budget for resident textures (bytes)
+#define ESP_TEXTURE_RESIDENCY_RESERVE 32768     // Internal RAM always left free when promoting
+#define ESP_TEXTURE_RESIDENCY_INTERVAL 30       // Frames between residency rebalances
+#define ESP_TEXTURE_MAX_RESIDENT       32       // Textures tracked for residency
+#define ESP_GLYPH_CACHE_ENTRIES       256       // Glyph cache hash table size (power of two)
+#define ESP_GLYPH_CACHE_BYTES       16384       // Glyph mask pool in internal RAM
+#define ESP_PROFILE_FRAMES            128       // Frames kept by the frame profiler
+#define ESP_PROFILE_LOG_INTERVAL        0       // Log frame profiler stats every this many frames (0: never)
+
 #endif // CONFIG_H
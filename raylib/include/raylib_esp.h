@@ -0,0 +1,263 @@
+/**********************************************************************************************
+*
+*   raylib_esp.h - ESP-IDF specific extensions to the raylib platform layer
+*
+*   Functions declared here are implemented by the component (rcore_esp_idf.c and friends)
+*   and must be called from the application, usually before InitWindow()
+*
+**********************************************************************************************/
+
+#ifndef RAYLIB_ESP_H
+#define RAYLIB_ESP_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+#include "esp_err.h"
+#include "esp_lcd_types.h"
+#include "raylib.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//----------------------------------------------------------------------------------
+// Display callbacks
+//----------------------------------------------------------------------------------
+
+// Register display flush and dimension callbacks (required, call before InitWindow)
+void raylib_esp_set_display_callbacks(
+    void (*flush_fn)(const uint16_t *buf, uint16_t x, uint16_t y, uint16_t w, uint16_t h),
+    void (*get_dim_fn)(uint16_t *w, uint16_t *h)
+);
+
+//----------------------------------------------------------------------------------
+// Panel present stage
+//----------------------------------------------------------------------------------
+
+typedef struct {
+    size_t max_transfer_sz;     // Bytes per draw_bitmap() call, as configured for the panel bus
+    uint8_t trans_queue_depth;  // Panel IO trans_queue_depth, bounds the DMA buffers in flight
+    bool swap_bytes;            // Panel expects big-endian RGB565 (SPI/QSPI panels)
+    uint8_t rgb_frame_buffers;  // RGB panels: present into this many panel frame buffers, swapped on vsync (0: off)
+    bool rgb_bounce_scanout;    // RGB panels without frame buffers: fill bounce buffers from the color buffer
+} raylib_esp_panel_config_t;
+
+#define RAYLIB_ESP_PANEL_CONFIG_DEFAULT() {     \
+    .max_transfer_sz = 0,                       \
+    .trans_queue_depth = 2,                     \
+    .swap_bytes = true,                         \
+    .rgb_frame_buffers = 0,                     \
+    .rgb_bounce_scanout = false,                \
+}
+
+// Present straight to an esp_lcd panel instead of through the flush callback (call before InitWindow)
+// Regions are read from the color buffer once, flipped and byte-swapped into DMA-capable bounce
+// buffers; io is used for on_color_trans_done and may be NULL for panels that copy synchronously
+// With rgb_frame_buffers set, regions go straight into the RGB panel frame buffers (num_fbs of the
+// panel config, at least this many) and the filled buffer is scanned out from the next vsync
+// With rgb_bounce_scanout set, the panel (created with no_fb and bounce_buffer_size_px) scans out
+// of the rlsw color buffer through on_bounce_empty, the application must not register RGB callbacks
+esp_err_t raylib_esp_set_panel(esp_lcd_panel_handle_t panel, esp_lcd_panel_io_handle_t io, const raylib_esp_panel_config_t *config);
+
+// Send a packed top-down RGB565 block through the panel bounce buffer ring, matches the
+// flush callback signature so custom flush callbacks can hand regions back to the component
+void raylib_esp_panel_flush(const uint16_t *buf, uint16_t x, uint16_t y, uint16_t w, uint16_t h);
+
+//----------------------------------------------------------------------------------
+// Present configuration
+//----------------------------------------------------------------------------------
+
+typedef enum {
+    RAYLIB_ESP_PRESENT_FULL = 0,    // Flush the whole screen every frame
+    RAYLIB_ESP_PRESENT_DAMAGE,      // Flush only regions touched by draw calls (dirty rectangles)
+    RAYLIB_ESP_PRESENT_TILE_DIFF,   // Flush only tiles whose checksum changed since the previous frame
+} raylib_esp_present_mode_t;
+
+typedef struct {
+    raylib_esp_present_mode_t mode; // Which screen regions are flushed on EndDrawing()
+    bool async;                     // Present on a dedicated task, EndDrawing() returns once the frame is queued
+                                    // (band mode: bands are sent from that task while the next is rasterized)
+    bool top_down;                  // Render with a flipped projection so rlsw rows are already in display order
+    uint16_t band_lines;            // Record the frame and rasterize it in bands of this many lines (0: full frame)
+    uint16_t tile_width;            // Band mode: rasterize each band in tiles this many pixels wide (0: full width)
+    uint8_t queue_depth;            // Number of present buffers (frames in flight, or bands in band mode) in async mode
+    int core_id;                    // Core the present task is pinned to (tskNO_AFFINITY allowed)
+    uint8_t task_priority;          // Present task priority
+    uint32_t task_stack_size;       // Present task stack size in bytes
+    uint32_t frame_tolerance_us;    // SetTargetFPS() pacing: lateness allowed before a deadline counts as missed,
+                                    // shorter waits are skipped instead of slept
+    bool lazy_redraw;               // WindowShouldClose() blocks until a redraw is requested (see raylib_esp_request_redraw())
+    uint32_t idle_redraw_ms;        // Lazy redraw: draw a frame anyway after this long without requests (0: never)
+} raylib_esp_present_config_t;
+
+#define RAYLIB_ESP_PRESENT_CONFIG_DEFAULT() {   \
+    .mode = RAYLIB_ESP_PRESENT_FULL,            \
+    .async = false,                             \
+    .top_down = false,                          \
+    .band_lines = 0,                            \
+    .tile_width = 0,                            \
+    .queue_depth = 2,                           \
+    .core_id = 0,                               \
+    .task_priority = 6,                         \
+    .task_stack_size = 4096,                    \
+    .frame_tolerance_us = 500,                  \
+    .lazy_redraw = false,                       \
+    .idle_redraw_ms = 0,                        \
+}
+
+// Set present configuration (call before InitWindow)
+void raylib_esp_set_present_config(const raylib_esp_present_config_t *config);
+
+// Mark a screen region as changed in RAYLIB_ESP_PRESENT_DAMAGE mode, for pixels written
+// outside of rlgl draw calls (e.g. directly into the color buffer), also requests a redraw
+void raylib_esp_invalidate_rect(int x, int y, int width, int height);
+
+// Lazy redraw: let the next WindowShouldClose() return so a frame is drawn (any task, or from
+// an interrupt handler with the _from_isr variant). Call it during a frame to keep animating
+void raylib_esp_request_redraw(void);
+void raylib_esp_request_redraw_from_isr(void);
+
+// Present statistics for the last frame
+typedef struct {
+    uint32_t frame;             // Frames presented since InitWindow()
+    uint32_t rects;             // Flush callback calls
+    uint32_t pixels;            // Pixels sent to the display
+    uint32_t tiles_total;       // Tiles compared (RAYLIB_ESP_PRESENT_TILE_DIFF only)
+    uint32_t tiles_skipped;     // Tiles unchanged and not sent (RAYLIB_ESP_PRESENT_TILE_DIFF only)
+    int32_t scanout_slack_us;   // Least time left before a bounce buffer deadline, last scanout frame (rgb_bounce_scanout only)
+    uint32_t scanout_underruns; // Bounce buffers filled too late since InitWindow() (rgb_bounce_scanout only)
+    int32_t frame_wait_us;      // Time the last frame slept to meet its SetTargetFPS() deadline
+    uint32_t deadline_misses;   // Frames later than their deadline plus frame_tolerance_us since InitWindow()
+    int32_t worst_late_us;      // Largest deadline overrun since InitWindow()
+    uint32_t idle_ms;           // Time WindowShouldClose() blocked waiting for a redraw since InitWindow() (lazy_redraw only)
+} raylib_esp_present_stats_t;
+
+void raylib_esp_get_present_stats(raylib_esp_present_stats_t *stats);
+
+// Internal RAM budget for resident textures in bytes (0 moves every texture back to PSRAM),
+// defaults to ESP_TEXTURE_RESIDENCY_BUDGET
+void raylib_esp_set_texture_budget(size_t bytes);
+
+// Texture residency statistics
+typedef struct {
+    uint32_t resident;          // Textures currently stored in internal RAM
+    uint32_t resident_bytes;    // Internal RAM used by them
+    uint32_t hits;              // Textured draws sampling internal RAM since InitWindow()
+    uint32_t misses;            // Textured draws of tracked textures sampling PSRAM since InitWindow()
+    uint32_t promotions;        // Moves to internal RAM since InitWindow()
+    uint32_t demotions;         // Moves back to PSRAM since InitWindow()
+} raylib_esp_texture_stats_t;
+
+void raylib_esp_get_texture_stats(raylib_esp_texture_stats_t *stats);
+
+// Keep RGB565 shadows (blit fast path) of textures uploaded while enabled, off by default:
+// enable around the LoadTexture() calls of sprites drawn unscaled
+void raylib_esp_set_texture_shadows(bool enable);
+
+// Block until every queued frame has been flushed to the display (no-op in sync mode)
+void raylib_esp_wait_present(void);
+
+//----------------------------------------------------------------------------------
+// Sprite batches
+//----------------------------------------------------------------------------------
+
+// Sprites sharing one texture, as parallel arrays of count entries (optional arrays may be NULL)
+typedef struct {
+    int count;
+    const float *x;             // Destination top-left corner (before rotation)
+    const float *y;
+    const Rectangle *source;    // Source rectangle per sprite, negative width/height flips (NULL: whole texture)
+    const Color *tint;          // Tint per sprite (NULL: WHITE)
+    const float *rotation;      // Degrees, clockwise around the sprite center (NULL: unrotated)
+    float scale;                // Uniform scale for every sprite (0 is treated as 1)
+} raylib_esp_sprite_batch_t;
+
+// Draw a sprite batch: one culling and transform pass and a single textured quad primitive,
+// unscaled and unrotated sprites take the texture blit fast path when available
+void raylib_esp_draw_sprite_batch(Texture2D texture, const raylib_esp_sprite_batch_t *batch);
+
+//----------------------------------------------------------------------------------
+// Retained layers
+//----------------------------------------------------------------------------------
+
+// Opaque screen rectangle drawn once and composited with row copies on later frames
+typedef struct raylib_esp_layer raylib_esp_layer_t;
+
+raylib_esp_layer_t *raylib_esp_layer_create(int x, int y, int width, int height, Color background);
+void raylib_esp_layer_destroy(raylib_esp_layer_t *layer);
+
+// Composite the layer and return false, or return true when its content must be drawn:
+// draw calls up to raylib_esp_layer_end() are clipped to the layer (do not nest scissor modes)
+bool raylib_esp_layer_begin(raylib_esp_layer_t *layer);
+void raylib_esp_layer_end(raylib_esp_layer_t *layer);
+
+// Redraw the layer content at the next raylib_esp_layer_begin()
+void raylib_esp_layer_invalidate(raylib_esp_layer_t *layer);
+
+//----------------------------------------------------------------------------------
+// Frame profiler (SUPPORT_ESP_PROFILER)
+//----------------------------------------------------------------------------------
+
+typedef enum {
+    RAYLIB_ESP_PHASE_DRAW = 0,      // BeginDrawing() to EndDrawing(): rasterizing, or recording in band mode
+    RAYLIB_ESP_PHASE_REPLAY,        // Band mode: rasterizing the recorded frame band by band
+    RAYLIB_ESP_PHASE_COPY,          // Copying or converting the color buffer into present buffers
+    RAYLIB_ESP_PHASE_FLUSH,         // Sending regions to the display (on the present task in async mode)
+    RAYLIB_ESP_PHASE_PACE,          // Sleeping to meet the SetTargetFPS() deadline
+    RAYLIB_ESP_PHASE_FRAME,         // BeginDrawing() to the end of pacing
+    RAYLIB_ESP_PHASE_COUNT
+} raylib_esp_phase_t;
+
+// Time spent in a phase per frame, over the recorded frames
+typedef struct {
+    uint32_t min_us;
+    uint32_t avg_us;
+    uint32_t p99_us;
+    uint32_t max_us;
+} raylib_esp_phase_stats_t;
+
+typedef struct {
+    uint32_t frames;            // Frames summarized (the last ESP_PROFILE_FRAMES at most)
+    raylib_esp_phase_stats_t phases[RAYLIB_ESP_PHASE_COUNT];
+} raylib_esp_frame_stats_t;
+
+// Per-phase timings of the last frames, returns false when the profiler is compiled out
+bool raylib_esp_get_frame_stats(raylib_esp_frame_stats_t *stats);
+
+// Trace events (SUPPORT_ESP_TRACE): with SystemView enabled in app_trace the frame phases and
+// trace points are sent as SystemView user events. Otherwise they are written to out as Chrome
+// trace_event JSON until raylib_esp_trace_stop() (out is not closed), returns false when tracing
+// is compiled out, already running or goes to SystemView
+bool raylib_esp_trace_start(FILE *out);
+void raylib_esp_trace_stop(void);
+
+//----------------------------------------------------------------------------------
+// Renderer statistics (SUPPORT_ESP_RENDER_STATS)
+//----------------------------------------------------------------------------------
+
+typedef struct {
+    uint32_t frame;                 // Frames counted since InitWindow()
+    uint32_t primitives;            // rlBegin()/rlEnd() primitives, each one rasterized by rlsw as submitted
+    uint32_t fast_draws;            // Rectangles, texture blits and text drawn by the span fast paths
+    uint32_t triangles;             // Triangles set up (quads count as two)
+    uint32_t triangles_rejected;    // Degenerate, off screen or scissored out
+    uint32_t lines;
+    uint32_t fragments;             // Screen pixels written by triangles and fast paths (lines and clears excluded)
+    uint32_t fragments_blended;     // Of those, pixels blended with translucent colors or textures
+    uint32_t texture_switches;      // Binds of a texture other than the last bound one
+} raylib_esp_render_stats_t;
+
+// Counters of the last presented frame, returns false when the statistics are compiled out
+bool raylib_esp_get_render_stats(raylib_esp_render_stats_t *stats);
+
+// Present a per-pixel overdraw heatmap instead of the frame colors from the next frame on
+// (full frame screen rendering only, not in band render mode)
+void raylib_esp_set_overdraw_heatmap(bool enable);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // RAYLIB_ESP_H
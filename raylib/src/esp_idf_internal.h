@@ -0,0 +1,247 @@
+/**********************************************************************************************
+*
+*   esp_idf_internal.h - Internal interfaces shared by the ESP-IDF platform sources
+*
+*   Not part of the public API, applications should include raylib_esp.h instead
+*
+**********************************************************************************************/
+
+#ifndef ESP_IDF_INTERNAL_H
+#define ESP_IDF_INTERNAL_H
+
+#include "raylib.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+// Screen-space rectangle in pixels (top-left origin)
+typedef struct {
+    int x;
+    int y;
+    int width;
+    int height;
+} EspRect;
+
+//----------------------------------------------------------------------------------
+// rcore_esp_idf.c
+//----------------------------------------------------------------------------------
+
+// Render orientation: true when rlsw rows are stored top-down (flipped projection)
+bool EspTopDownEnabled(void);
+
+// Band render mode: lines per band, 0 when the frame is rasterized in full
+int EspBandLines(void);
+
+// Route rlsw allocations (SW_MALLOC) to internal RAM instead of PSRAM
+void EspSwMallocInternal(bool internal);
+
+// Damage tracking (dirty rectangles flushed by SwapScreenBuffer)
+bool EspDamageEnabled(void);
+void EspDamageAdd(int x, int y, int width, int height);
+void EspDamageAddFull(void);
+
+//----------------------------------------------------------------------------------
+// rpanel_esp_idf.c
+//----------------------------------------------------------------------------------
+
+bool EspPanelAttached(void);
+bool EspPanelInit(int width, int height);
+void EspPanelClose(void);
+void EspPanelDraw(const uint16_t *first, int rowStep, EspRect rect);
+void EspPanelFrameEnd(void);
+
+// RGB panel frame buffers presented into, 0 when regions go through bounce buffers
+int EspPanelFrameBufferCount(void);
+
+// RGB bounce buffer scanout straight from the presented frame
+bool EspPanelScanout(void);
+void EspPanelScanoutStats(int32_t *minSlackUs, uint32_t *underruns);
+
+//----------------------------------------------------------------------------------
+// rlgl_esp_idf.c
+//----------------------------------------------------------------------------------
+
+// rlsw color buffer while drawing to the screen, NULL in render textures and band mode
+uint16_t *EspScreenTarget(int *width, int *height);
+
+//----------------------------------------------------------------------------------
+// rlist_esp_idf.c
+//----------------------------------------------------------------------------------
+
+// Display list operations, recorded from interposed rlgl/rcore calls
+typedef enum {
+    ESP_LIST_BEGIN = 0,         // arg: primitive mode, binned screen bounds and end index set by EspListEndPrimitive()
+    ESP_LIST_END,
+    ESP_LIST_VERTEX2,           // v: x, y
+    ESP_LIST_VERTEX3,           // v: x, y, z
+    ESP_LIST_TEXCOORD,          // v: u, v
+    ESP_LIST_NORMAL,            // v: x, y, z
+    ESP_LIST_COLOR,             // v: r, g, b, a (0..255)
+    ESP_LIST_TEXTURE,           // v: texture id
+    ESP_LIST_MATRIX_MODE,       // arg: matrix mode
+    ESP_LIST_PUSH,
+    ESP_LIST_POP,
+    ESP_LIST_IDENTITY,
+    ESP_LIST_TRANSLATE,         // v: x, y, z
+    ESP_LIST_ROTATE,            // v: angle, x, y, z
+    ESP_LIST_SCALE,             // v: x, y, z
+    ESP_LIST_MULT,              // Followed by four ESP_LIST_MATRIX_DATA ops (matrix columns)
+    ESP_LIST_MATRIX_DATA,
+    ESP_LIST_CLEAR,             // v: r, g, b, a
+    ESP_LIST_SCISSOR,           // v: screen rect (x, y, width, height)
+    ESP_LIST_SCISSOR_END,
+    ESP_LIST_BLEND,             // arg: blend mode
+    ESP_LIST_PROJECTION,        // Full-screen projection cropped to the replayed area, four ESP_LIST_MATRIX_DATA ops follow
+    ESP_LIST_DEPTH_TEST,        // arg: 1 to enable depth testing (depth cleared on first use), 0 to disable
+} EspListOpType;
+
+bool EspListRecording(void);
+void EspListBegin(void);
+void EspListEnd(void);
+void EspListAdd(EspListOpType type, int arg, float a, float b, float c, float d);
+void EspListAddMatrix(const float *matf);
+void EspListAddProjection(const float *matf);
+void EspListEndPrimitive(bool visible, EspRect bounds);
+void EspListReplay(EspRect clip, int bufferRow);
+void EspListClose(void);
+
+//----------------------------------------------------------------------------------
+// rtexture_esp_idf.c
+//----------------------------------------------------------------------------------
+
+typedef enum {
+    ESP_TEXTURE_OPAQUE = 0,     // Every texel alpha 255: plain row copies
+    ESP_TEXTURE_KEYED,          // Alpha 0 or 255 only: transparent texels skipped
+    ESP_TEXTURE_BLENDED,
+} EspTextureKind;
+
+// Classification of an uploaded texture (top mipmap level), with an RGB565 copy for unscaled
+// blits when shadows were enabled at upload
+typedef struct {
+    unsigned int id;
+    int width;
+    int height;
+    EspTextureKind kind;
+    uint16_t *pixels;           // NULL without shadow
+    uint8_t *alpha;             // With pixels, or for GRAY_ALPHA font atlases (glyph cache), NULL for opaque textures
+} EspTextureShadow;
+
+const EspTextureShadow *EspTextureFind(unsigned int id);
+void EspTextureClose(void);
+
+// Texture residency: textured draw accounting and per-frame rebalancing
+void EspTextureUse(unsigned int id);
+void EspTextureFrame(void);
+
+//----------------------------------------------------------------------------------
+// rtext_esp_idf.c
+//----------------------------------------------------------------------------------
+
+// Pre-scaled glyph alpha mask, origin relative to the pen position
+typedef struct {
+    int16_t x;
+    int16_t y;
+    int16_t width;
+    int16_t height;
+    const uint8_t *mask;
+} EspGlyph;
+
+const EspGlyph *EspGlyphFind(Font font, int index, float fontSize);
+void EspGlyphCacheClear(void);
+void EspGlyphCacheClose(void);
+
+//----------------------------------------------------------------------------------
+// rprofile_esp_idf.c
+//----------------------------------------------------------------------------------
+
+// Phase markers (raylib_esp_phase_t), compiled out with SUPPORT_ESP_PROFILER 0, phases are
+// trace events as well
+#if SUPPORT_ESP_PROFILER
+    #define ESP_PROFILE_BEGIN(phase) (EspProfileBegin(phase), ESP_TRACE_BEGIN(phase))
+    #define ESP_PROFILE_END(phase) (ESP_TRACE_END(phase), EspProfileEnd(phase))
+    #define ESP_PROFILE_FRAME() EspProfileFrame()
+#else
+    #define ESP_PROFILE_BEGIN(phase) ESP_TRACE_BEGIN(phase)
+    #define ESP_PROFILE_END(phase) ESP_TRACE_END(phase)
+    #define ESP_PROFILE_FRAME() ((void)0)
+#endif
+
+void EspProfileBegin(int phase);
+void EspProfileEnd(int phase);
+void EspProfileFrame(void);
+void EspProfileReset(void);
+
+//----------------------------------------------------------------------------------
+// rtrace_esp_idf.c
+//----------------------------------------------------------------------------------
+
+// Trace events: the raylib_esp_phase_t values, then these
+typedef enum {
+    ESP_TRACE_SWAP = 8,             // SwapScreenBuffer()
+    ESP_TRACE_FLUSH_CALLBACK,       // One flush callback or panel draw call
+    ESP_TRACE_POLL_INPUT,           // PollInputEvents()
+    ESP_TRACE_EVENT_COUNT
+} EspTraceEvent;
+
+// Trace points, compiled out with SUPPORT_ESP_TRACE 0
+#if SUPPORT_ESP_TRACE
+    #define ESP_TRACE_BEGIN(event) EspTraceBegin(event)
+    #define ESP_TRACE_END(event) EspTraceEnd(event)
+    #define ESP_TRACE_MARK(event) EspTraceMark(event)
+#else
+    #define ESP_TRACE_BEGIN(event) ((void)0)
+    #define ESP_TRACE_END(event) ((void)0)
+    #define ESP_TRACE_MARK(event) ((void)0)
+#endif
+
+void EspTraceBegin(int event);
+void EspTraceEnd(int event);
+void EspTraceMark(int event);
+
+//----------------------------------------------------------------------------------
+// rstats_esp_idf.c
+//----------------------------------------------------------------------------------
+
+// Renderer statistics hooks, compiled out with SUPPORT_ESP_RENDER_STATS 0
+#if SUPPORT_ESP_RENDER_STATS
+    #define ESP_RENDER_STATS(call) call
+#else
+    #define ESP_RENDER_STATS(call) ((void)0)
+#endif
+
+void EspStatsBegin(int mode, bool screenSpace, EspRect clip);
+void EspStatsVertex(float x, float y);
+void EspStatsColor(unsigned char alpha);
+void EspStatsTexture(unsigned int id);
+void EspStatsRect(int x0, int y0, int x1, int y1, bool blended);
+void EspStatsFastDraw(void);
+void EspStatsFrameBegin(void);
+void EspStatsFrameEnd(void);
+void EspStatsClose(void);
+
+//----------------------------------------------------------------------------------
+// rpixel_esp_idf.c
+//----------------------------------------------------------------------------------
+
+void EspPixelCopy(uint16_t *dst, const uint16_t *src, int count);
+void EspPixelSwapCopy(uint16_t *dst, const uint16_t *src, int count);
+void EspPixelCopyRows(uint16_t *dst, int dstStride, const uint16_t *first, int rowStep, int width, int rows, bool swap);
+void EspPixelFill(uint16_t *dst, uint16_t color, int count);
+void EspPixelBlend(uint16_t *dst, uint16_t color, int alpha, int count);
+void EspPixelBlitKeyed(uint16_t *dst, const uint16_t *src, const uint8_t *alpha, int count);
+void EspPixelBlitBlend(uint16_t *dst, const uint16_t *src, const uint8_t *alpha, uint32_t tint, int count);
+void EspPixelMask(uint16_t *dst, const uint8_t *mask, uint16_t color, int alpha, int count);
+
+// Scalar copies safe to call from IRAM ISRs (no PIE, no flash-resident code)
+void EspPixelCopyIsr(uint16_t *dst, const uint16_t *src, int count);
+void EspPixelSwapCopyIsr(uint16_t *dst, const uint16_t *src, int count);
+
+//----------------------------------------------------------------------------------
+// rpixel_pie_esp_idf.S (ESP32-S3)
+//----------------------------------------------------------------------------------
+
+// 16-byte aligned dst and src (or color), whole 128-bit blocks: 8 pixels, 16 for swaps
+void EspPixelCopyPie(uint16_t *dst, const uint16_t *src, int blocks);
+void EspPixelSwapCopyPie(uint16_t *dst, const uint16_t *src, int blocks);
+void EspPixelFillPie(uint16_t *dst, const uint16_t *color, int blocks);
+
+#endif // ESP_IDF_INTERNAL_H
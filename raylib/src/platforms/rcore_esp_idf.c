@@ -9,11 +9,20 @@
 #include "config.h"
 #include "raylib.h"
 #include "rlgl.h"
+#include "raylib_esp.h"
+#include "esp_idf_internal.h"
 #include <string.h>
 
 #include "esp_log.h"
 #include "esp_heap_caps.h"
+#include "esp_timer.h"
+#include "sdkconfig.h"
+#if CONFIG_PM_ENABLE
+    #include "esp_pm.h"
+#endif
 #include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/queue.h"
 #include "freertos/semphr.h"
 
 //----------------------------------------------------------------------------------
@@ -52,13 +61,84 @@ static void (*s_get_dimensions)(uint16_t *w, uint16_t *h) = NULL;
 //----------------------------------------------------------------------------------
 // Framebuffer
 //----------------------------------------------------------------------------------
-static uint16_t *s_framebuffer = NULL;
+static uint16_t *s_framebuffers[ESP_PRESENT_MAX_QUEUE_DEPTH] = { 0 };
+static int s_framebuffer_count = 0;
 static int s_screen_width = 0;
 static int s_screen_height = 0;
 static SemaphoreHandle_t s_flush_mutex = NULL;
 
+//----------------------------------------------------------------------------------
+// Present (sync or async on a dedicated flush task)
+//----------------------------------------------------------------------------------
+#define PRESENT_MAX_RECTS ESP_DAMAGE_MAX_RECTS
+#define PRESENT_USE_RECTS (SUPPORT_ESP_DAMAGE_TRACKING || SUPPORT_ESP_TILE_DIFF)
+
+// Screen regions packed back to back into one framebuffer
+typedef struct {
+    EspRect rects[PRESENT_MAX_RECTS];
+    int count;
+} PresentJob;
+
+static raylib_esp_present_config_t s_present_config = RAYLIB_ESP_PRESENT_CONFIG_DEFAULT();
+static PresentJob s_present_jobs[ESP_PRESENT_MAX_QUEUE_DEPTH] = { 0 };
+static raylib_esp_present_stats_t s_present_stats = { 0 };
+
+#if PRESENT_USE_RECTS
+//----------------------------------------------------------------------------------
+// Damage (dirty rectangles collected since the last present)
+//----------------------------------------------------------------------------------
+static EspRect s_damage_rects[ESP_DAMAGE_MAX_RECTS];
+static int s_damage_count = 0;
+static bool s_damage_full = true;   // First frame always goes out in full
+#endif
+
+#if SUPPORT_ESP_TILE_DIFF
+//----------------------------------------------------------------------------------
+// Tile checksums of the last presented frame
+//----------------------------------------------------------------------------------
+static uint32_t *s_tile_hashes = NULL;
+static int s_tiles_x = 0;
+static int s_tiles_y = 0;
+#endif
+
+#if SUPPORT_ESP_BAND_RENDER
+//----------------------------------------------------------------------------------
+// Band render mode (frame recorded as a display list, rasterized one band at a time)
+//----------------------------------------------------------------------------------
+static uint16_t *s_band_staging = NULL;     // Top-down band for flush callbacks (no panel stage)
+static bool s_band_ready = false;           // rlsw buffers shrunk to one band per slot
+static const uint16_t *s_band_buffer = NULL;    // rlsw color buffer holding the band slots
+static int s_tile_width = 0;                // Width of each band slot, screen width unless tiled
+static int s_band_slots = 1;                // Bands in flight, > 1 when presented from the present task
+static EspRect s_band_rects[ESP_PRESENT_MAX_QUEUE_DEPTH] = { 0 };    // Screen area held by each slot
+#endif
+static bool s_sw_malloc_internal = false;   // Route rlsw allocations to internal RAM
+
+// Frame clock
+static int64_t s_time_base = 0;                 // esp_timer time at InitPlatform(), GetTime() origin
+static int64_t s_frame_period_us = 0;           // SetTargetFPS() period, 0 when unpaced
+static int64_t s_frame_deadline = 0;            // End of the current paced frame
+static esp_timer_handle_t s_frame_timer = NULL; // One-shot wake-up for paced waits
+static SemaphoreHandle_t s_frame_wake = NULL;
+static SemaphoreHandle_t s_redraw_event = NULL; // Lazy redraw: given by redraw requests, taken by WindowShouldClose()
+#if CONFIG_PM_ENABLE
+static esp_pm_lock_handle_t s_frame_pm_lock = NULL; // Lazy redraw: no light sleep while a frame renders and presents
+#endif
+
+#if SUPPORT_ESP_ASYNC_PRESENT
+static TaskHandle_t s_present_task = NULL;
+static TaskHandle_t s_present_closer = NULL;
+static QueueHandle_t s_present_queue = NULL;    // Framebuffer indices ready to flush
+static QueueHandle_t s_free_queue = NULL;       // Framebuffer indices ready to be filled
+static int s_present_depth = 0;                 // Indices cycling through the queues
+#endif
+
+// Real implementations (resolved by the linker, see rlgl_esp_idf.c)
+void __real_SetTargetFPS(int fps);
+
 // External software renderer API
 extern void *swGetColorBuffer(int *width, int *height);
+extern bool swResizeFramebuffer(int width, int height);
 
 // RLSW state structure
 extern struct {
@@ -76,6 +156,28 @@ extern struct {
 // Check if application should close
 bool WindowShouldClose(void)
 {
+    // Lazy redraw: block until the next redraw request, the idle task may light sleep meanwhile
+    if (s_redraw_event) {
+        TickType_t timeout = (s_present_config.idle_redraw_ms > 0)? pdMS_TO_TICKS(s_present_config.idle_redraw_ms) : portMAX_DELAY;
+        int64_t start = esp_timer_get_time();
+
+        // Frames still being sent must not be cut short by light sleep
+        raylib_esp_wait_present();
+#if CONFIG_PM_ENABLE
+        if (s_frame_pm_lock) esp_pm_lock_release(s_frame_pm_lock);
+#endif
+        xSemaphoreTake(s_redraw_event, timeout);
+#if CONFIG_PM_ENABLE
+        if (s_frame_pm_lock) esp_pm_lock_acquire(s_frame_pm_lock);
+#endif
+
+        int64_t idle = esp_timer_get_time() - start;
+        s_present_stats.idle_ms += (uint32_t)(idle/1000);
+
+        // A frame after an idle period starts a new pacing schedule instead of counting as late
+        if (idle > s_frame_period_us) s_frame_deadline = 0;
+    }
+
     return false;  // Embedded: run continuously
 }
 
@@ -89,10 +191,531 @@ void raylib_esp_set_display_callbacks(
     s_get_dimensions = get_dim_fn;
 }
 
+void raylib_esp_set_present_config(const raylib_esp_present_config_t *config)
+{
+    if (config) s_present_config = *config;
+}
+
+//----------------------------------------------------------------------------------
+// Damage tracking
+//----------------------------------------------------------------------------------
+
+#if PRESENT_USE_RECTS
+static int RectArea(EspRect r) { return r.width * r.height; }
+
+static EspRect RectUnion(EspRect a, EspRect b)
+{
+    int x0 = (a.x < b.x)? a.x : b.x;
+    int y0 = (a.y < b.y)? a.y : b.y;
+    int x1 = (a.x + a.width > b.x + b.width)? a.x + a.width : b.x + b.width;
+    int y1 = (a.y + a.height > b.y + b.height)? a.y + a.height : b.y + b.height;
+    return (EspRect){ x0, y0, x1 - x0, y1 - y0 };
+}
+
+// Pixels flushed needlessly if a and b were sent as their union
+static int RectMergeWaste(EspRect a, EspRect b)
+{
+    int ix = ((a.x + a.width < b.x + b.width)? a.x + a.width : b.x + b.width) - ((a.x > b.x)? a.x : b.x);
+    int iy = ((a.y + a.height < b.y + b.height)? a.y + a.height : b.y + b.height) - ((a.y > b.y)? a.y : b.y);
+    int overlap = ((ix > 0) && (iy > 0))? ix*iy : 0;
+    return RectArea(RectUnion(a, b)) - RectArea(a) - RectArea(b) + overlap;
+}
+#endif
+
+bool EspTopDownEnabled(void)
+{
+    return s_present_config.top_down;
+}
+
+// Sync present reads the rlsw color buffer in place, no framebuffer needed, when the panel
+// stage does the flip itself or rows are already top-down
+static bool PresentInPlace(void)
+{
+#if SUPPORT_ESP_ASYNC_PRESENT
+    if (s_present_config.async) return false;
+#endif
+    return s_present_config.top_down || EspPanelAttached();
+}
+
+int EspBandLines(void)
+{
+#if SUPPORT_ESP_BAND_RENDER
+    return s_present_config.band_lines;
+#else
+    return 0;
+#endif
+}
+
+// Heap caps for rlsw allocations (SW_MALLOC in config.h)
+uint32_t EspSwMallocCaps(void)
+{
+    return s_sw_malloc_internal? (MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT) : (MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+}
+
+void EspSwMallocInternal(bool internal)
+{
+    s_sw_malloc_internal = internal;
+}
+
+bool EspDamageEnabled(void)
+{
+#if SUPPORT_ESP_DAMAGE_TRACKING
+    return (s_present_config.mode == RAYLIB_ESP_PRESENT_DAMAGE);
+#else
+    return false;
+#endif
+}
+
+void EspDamageAddFull(void)
+{
+#if PRESENT_USE_RECTS
+    s_damage_full = true;
+#endif
+}
+
+void EspDamageAdd(int x, int y, int width, int height)
+{
+#if PRESENT_USE_RECTS
+    if (s_damage_full) return;
+
+    // Clip to screen
+    if (x < 0) { width += x; x = 0; }
+    if (y < 0) { height += y; y = 0; }
+    if (x + width > s_screen_width) width = s_screen_width - x;
+    if (y + height > s_screen_height) height = s_screen_height - y;
+    if ((width <= 0) || (height <= 0)) return;
+
+    EspRect rect = { x, y, width, height };
+
+    // Absorb every rectangle that is cheap to merge with, restarting since the union grows
+    for (int i = 0; i < s_damage_count; i++) {
+        if (RectMergeWaste(rect, s_damage_rects[i]) <= ESP_DAMAGE_MERGE_WASTE) {
+            rect = RectUnion(rect, s_damage_rects[i]);
+            s_damage_rects[i] = s_damage_rects[--s_damage_count];
+            i = -1;
+        }
+    }
+
+    // Out of slots: merge with the rectangle that wastes the fewest pixels
+    if (s_damage_count == ESP_DAMAGE_MAX_RECTS) {
+        int best = 0;
+        int bestWaste = RectMergeWaste(rect, s_damage_rects[0]);
+        for (int i = 1; i < s_damage_count; i++) {
+            int waste = RectMergeWaste(rect, s_damage_rects[i]);
+            if (waste < bestWaste) { best = i; bestWaste = waste; }
+        }
+        rect = RectUnion(rect, s_damage_rects[best]);
+        s_damage_rects[best] = s_damage_rects[--s_damage_count];
+    }
+
+    s_damage_rects[s_damage_count++] = rect;
+
+    // Large damage is cheaper as a single transfer, this also bounds the packed size to one frame
+    int area = 0;
+    for (int i = 0; i < s_damage_count; i++) area += RectArea(s_damage_rects[i]);
+    if (area*100 >= s_screen_width*s_screen_height*ESP_DAMAGE_FULL_PERCENT) s_damage_full = true;
+#endif
+}
+
+void raylib_esp_invalidate_rect(int x, int y, int width, int height)
+{
+    EspDamageAdd(x, y, width, height);
+    raylib_esp_request_redraw();
+}
+
+void raylib_esp_request_redraw(void)
+{
+    if (s_redraw_event) xSemaphoreGive(s_redraw_event);
+}
+
+void raylib_esp_request_redraw_from_isr(void)
+{
+    if (!s_redraw_event) return;
+
+    BaseType_t woken = pdFALSE;
+    xSemaphoreGiveFromISR(s_redraw_event, &woken);
+    portYIELD_FROM_ISR(woken);
+}
+
+void raylib_esp_get_present_stats(raylib_esp_present_stats_t *stats)
+{
+    if (!stats) return;
+
+    *stats = s_present_stats;
+    EspPanelScanoutStats(&stats->scanout_slack_us, &stats->scanout_underruns);
+}
+
+//----------------------------------------------------------------------------------
+// Tile differencing
+//----------------------------------------------------------------------------------
+
+#if SUPPORT_ESP_TILE_DIFF
+#define TILE_MAX_SPANS 32   // Changed spans per tile row, extra tiles extend the last span
+
+// Checksum of one tile of the rlsw color buffer (screen rows, x and width even)
+static uint32_t TileHash(const uint16_t *src, int x, int y, int width, int height)
+{
+    uint32_t hash = 2166136261u;
+    bool flip = !s_present_config.top_down;
+
+    for (int row = 0; row < height; row++) {
+        int srcRow = flip? (s_screen_height - 1 - (y + row)) : (y + row);
+        const uint32_t *words = (const uint32_t *)(src + (srcRow * s_screen_width) + x);
+        for (int i = 0; i < width/2; i++) {
+            hash = (hash ^ words[i]) * 16777619u;
+        }
+    }
+
+    return hash;
+}
+
+// Hash every tile, report changed tiles as damage (spans merged along rows, then down columns)
+static void DiffTiles(const uint16_t *src)
+{
+    EspRect spans[2][TILE_MAX_SPANS];
+    int spanCount[2] = { 0, 0 };
+    int skipped = 0;
+
+    for (int ty = 0; ty < s_tiles_y; ty++) {
+        int cur = ty & 1;
+        int prev = cur ^ 1;
+        int y = ty * ESP_TILE_HEIGHT;
+        int height = (y + ESP_TILE_HEIGHT > s_screen_height)? s_screen_height - y : ESP_TILE_HEIGHT;
+
+        spanCount[cur] = 0;
+
+        for (int tx = 0; tx < s_tiles_x; tx++) {
+            int x = tx * ESP_TILE_WIDTH;
+            int width = (x + ESP_TILE_WIDTH > s_screen_width)? s_screen_width - x : ESP_TILE_WIDTH;
+            uint32_t hash = TileHash(src, x, y, width, height);
+            uint32_t *stored = &s_tile_hashes[ty * s_tiles_x + tx];
+
+            if (*stored == hash) {
+                skipped++;
+                continue;
+            }
+            *stored = hash;
+
+            // Extend the open span if this tile continues it
+            EspRect *last = (spanCount[cur] > 0)? &spans[cur][spanCount[cur] - 1] : NULL;
+            if (last && (last->x + last->width == x)) last->width += width;
+            else if (spanCount[cur] < TILE_MAX_SPANS) spans[cur][spanCount[cur]++] = (EspRect){ x, y, width, height };
+            else last->width = x + width - last->x;
+        }
+
+        // Spans identical to one in the previous tile row grow that one instead
+        for (int i = 0; i < spanCount[cur]; i++) {
+            EspRect *span = &spans[cur][i];
+            for (int j = 0; j < spanCount[prev]; j++) {
+                EspRect *above = &spans[prev][j];
+                if ((above->x == span->x) && (above->width == span->width) && (above->y + above->height == span->y)) {
+                    span->y = above->y;
+                    span->height += above->height;
+                    above->width = 0;
+                    break;
+                }
+            }
+        }
+
+        for (int j = 0; j < spanCount[prev]; j++) {
+            if (spans[prev][j].width > 0) EspDamageAdd(spans[prev][j].x, spans[prev][j].y, spans[prev][j].width, spans[prev][j].height);
+        }
+        spanCount[prev] = 0;
+    }
+
+    int last = (s_tiles_y - 1) & 1;
+    for (int j = 0; j < spanCount[last]; j++) {
+        EspDamageAdd(spans[last][j].x, spans[last][j].y, spans[last][j].width, spans[last][j].height);
+    }
+
+    s_present_stats.tiles_total = s_tiles_x * s_tiles_y;
+    s_present_stats.tiles_skipped = skipped;
+}
+#endif
+
+// Take the regions to present this frame and reset damage for the next one
+static void CollectPresentRects(PresentJob *job, const uint16_t *src)
+{
+#if SUPPORT_ESP_TILE_DIFF
+    if (s_tile_hashes && (s_present_config.mode == RAYLIB_ESP_PRESENT_TILE_DIFF)) DiffTiles(src);
+#endif
+
+    job->rects[0] = (EspRect){ 0, 0, s_screen_width, s_screen_height };
+    job->count = 1;
+
+#if PRESENT_USE_RECTS
+    if ((s_present_config.mode != RAYLIB_ESP_PRESENT_FULL) && !s_damage_full) {
+        memcpy(job->rects, s_damage_rects, s_damage_count*sizeof(EspRect));
+        job->count = s_damage_count;
+    }
+
+    s_damage_count = 0;
+    s_damage_full = false;
+#endif
+
+    // Flush callbacks read in place need regions contiguous in the color buffer: widen to full rows
+    // and merge overlapping bands (the panel stage handles any region)
+    if (PresentInPlace() && !EspPanelAttached() && (job->count > 1 || job->rects[0].width != s_screen_width)) {
+        for (int i = 0; i < job->count; i++) {
+            job->rects[i].x = 0;
+            job->rects[i].width = s_screen_width;
+        }
+        for (int i = 0; i < job->count; i++) {
+            for (int j = i + 1; j < job->count; j++) {
+                EspRect *a = &job->rects[i];
+                EspRect *b = &job->rects[j];
+                if ((b->y <= a->y + a->height) && (a->y <= b->y + b->height)) {
+                    int y0 = (a->y < b->y)? a->y : b->y;
+                    int y1 = (a->y + a->height > b->y + b->height)? a->y + a->height : b->y + b->height;
+                    a->y = y0;
+                    a->height = y1 - y0;
+                    *b = job->rects[--job->count];
+                    j = i;
+                }
+            }
+        }
+    }
+
+    s_present_stats.frame++;
+    s_present_stats.rects = job->count;
+    s_present_stats.pixels = 0;
+    for (int i = 0; i < job->count; i++) s_present_stats.pixels += job->rects[i].width * job->rects[i].height;
+}
+
+//----------------------------------------------------------------------------------
+// Present
+//----------------------------------------------------------------------------------
+
+// Copy job regions out of the rlsw color buffer, packed top-down one after another
+// (vertical flip unless rows are already stored top-down)
+static void CopyJob(uint16_t *dst, const uint16_t *src, const PresentJob *job)
+{
+    bool flip = !s_present_config.top_down;
+
+    ESP_PROFILE_BEGIN(RAYLIB_ESP_PHASE_COPY);
+    for (int i = 0; i < job->count; i++) {
+        EspRect r = job->rects[i];
+        int src_row = flip? s_screen_height - 1 - r.y : r.y;
+        EspPixelCopyRows(dst, r.width, src + (src_row * s_screen_width) + r.x,
+                         flip? -s_screen_width : s_screen_width, r.width, r.height, false);
+        dst += r.width * r.height;
+    }
+    ESP_PROFILE_END(RAYLIB_ESP_PHASE_COPY);
+}
+
+// Send job regions to the display (thread-safe), either packed one after another or read
+// in place from the rlsw color buffer
+static void FlushJob(const uint16_t *buf, const PresentJob *job, bool packed)
+{
+    if (s_flush_mutex) {
+        xSemaphoreTake(s_flush_mutex, portMAX_DELAY);
+    }
+    ESP_PROFILE_BEGIN(RAYLIB_ESP_PHASE_FLUSH);
+    for (int i = 0; i < job->count; i++) {
+        EspRect r = job->rects[i];
+        const uint16_t *first = NULL;
+        int rowStep = 0;
+
+        if (packed) {
+            first = buf;
+            rowStep = r.width;
+            buf += r.width * r.height;
+        }
+        else if (s_present_config.top_down) {
+            first = buf + (r.y * s_screen_width) + r.x;
+            rowStep = s_screen_width;
+        }
+        else {
+            first = buf + ((s_screen_height - 1 - r.y) * s_screen_width) + r.x;
+            rowStep = -s_screen_width;
+        }
+
+        // In place flush callbacks only get full-width top-down bands, contiguous in memory
+        ESP_TRACE_BEGIN(ESP_TRACE_FLUSH_CALLBACK);
+        if (EspPanelAttached()) EspPanelDraw(first, rowStep, r);
+        else s_display_flush(first, r.x, r.y, r.width, r.height);
+        ESP_TRACE_END(ESP_TRACE_FLUSH_CALLBACK);
+    }
+    if (EspPanelAttached()) EspPanelFrameEnd();
+    ESP_PROFILE_END(RAYLIB_ESP_PHASE_FLUSH);
+    if (s_flush_mutex) {
+        xSemaphoreGive(s_flush_mutex);
+    }
+}
+
+#if SUPPORT_ESP_BAND_RENDER
+// Send one rasterized band (or tile), slots are stacked bottom-up in the rlsw color buffer
+// and the band top row is the last row of its slot
+static void FlushBand(int slot)
+{
+    int lines = s_present_config.band_lines;
+    EspRect r = s_band_rects[slot];
+    const uint16_t *first = s_band_buffer + (((slot * lines) + lines - 1) * s_tile_width);
+
+    ESP_PROFILE_BEGIN(RAYLIB_ESP_PHASE_FLUSH);
+    if (EspPanelAttached()) {
+        ESP_TRACE_BEGIN(ESP_TRACE_FLUSH_CALLBACK);
+        EspPanelDraw(first, -s_tile_width, r);
+        ESP_TRACE_END(ESP_TRACE_FLUSH_CALLBACK);
+    }
+    else {
+        EspPixelCopyRows(s_band_staging, r.width, first, -s_tile_width, r.width, r.height, false);
+        ESP_TRACE_BEGIN(ESP_TRACE_FLUSH_CALLBACK);
+        s_display_flush(s_band_staging, r.x, r.y, r.width, r.height);
+        ESP_TRACE_END(ESP_TRACE_FLUSH_CALLBACK);
+    }
+    ESP_PROFILE_END(RAYLIB_ESP_PHASE_FLUSH);
+}
+
+// Screen area of the band or tile at (x, y), cut at the screen edges
+static EspRect BandRect(int x, int y)
+{
+    int lines = s_present_config.band_lines;
+    return (EspRect){ x, y, (x + s_tile_width > s_screen_width)? s_screen_width - x : s_tile_width,
+                      (y + lines > s_screen_height)? s_screen_height - y : lines };
+}
+#endif
+
+#if SUPPORT_ESP_ASYNC_PRESENT
+// Present task: flush queued framebuffers (or band slots) and hand them back to the renderer
+static void PresentTask(void *arg)
+{
+    int index = 0;
+
+    while (xQueueReceive(s_present_queue, &index, portMAX_DELAY) == pdTRUE) {
+        if (index < 0) break;   // Shutdown request from ClosePlatform()
+
+#if SUPPORT_ESP_BAND_RENDER
+        if (EspBandLines() > 0) {
+            if (s_flush_mutex) xSemaphoreTake(s_flush_mutex, portMAX_DELAY);
+            FlushBand(index);
+            EspRect r = s_band_rects[index];
+            if (EspPanelAttached() && (r.y + r.height >= s_screen_height) && (r.x + r.width >= s_screen_width)) EspPanelFrameEnd();
+            if (s_flush_mutex) xSemaphoreGive(s_flush_mutex);
+
+            xQueueSend(s_free_queue, &index, portMAX_DELAY);
+            continue;
+        }
+#endif
+        FlushJob(s_framebuffers[index], &s_present_jobs[index], true);
+        xQueueSend(s_free_queue, &index, portMAX_DELAY);
+    }
+
+    xTaskNotifyGive(s_present_closer);
+    vTaskDelete(NULL);
+}
+#endif
+
+void raylib_esp_wait_present(void)
+{
+#if SUPPORT_ESP_ASYNC_PRESENT
+    if (!s_present_task) return;
+
+    // All framebuffers back in the free queue means nothing is left in flight
+    int indices[ESP_PRESENT_MAX_QUEUE_DEPTH];
+    for (int i = 0; i < s_present_depth; i++) {
+        xQueueReceive(s_free_queue, &indices[i], portMAX_DELAY);
+    }
+    for (int i = 0; i < s_present_depth; i++) {
+        xQueueSend(s_free_queue, &indices[i], 0);
+    }
+#endif
+}
+
 // Swap back buffer with front buffer (screen drawing)
-void SwapScreenBuffer(void)
+#if SUPPORT_ESP_BAND_RENDER
+// Rasterize the recorded frame band by band (or tile by tile) into the band-sized rlsw buffer
+// in internal RAM, each band is sent as soon as it is done; with several slots the present
+// task sends band k from the other core while band k+1 is rasterized into the next slot
+// (pipelined present: rasterization itself stays on this core)
+static void PresentBands(void)
 {
-    if (!s_framebuffer || !s_display_flush) {
+    EspListEnd();
+
+    if (!s_display_flush && !EspPanelAttached()) {
+        ESP_LOGE("RAYLIB", "Flush callback not set!");
+        return;
+    }
+
+    int lines = s_present_config.band_lines;
+
+    if (!s_band_ready) {
+        // Shrink rlsw color and depth buffers to one band per slot, preferring internal RAM
+        s_sw_malloc_internal = true;
+        s_band_ready = swResizeFramebuffer(s_tile_width, lines * s_band_slots);
+        s_sw_malloc_internal = false;
+
+        int sw_width = 0, sw_height = 0;
+        if (s_band_ready) s_band_buffer = (const uint16_t *)swGetColorBuffer(&sw_width, &sw_height);
+        if (!s_band_buffer || sw_width != s_tile_width || sw_height != lines * s_band_slots) {
+            ESP_LOGE("RAYLIB", "Failed to resize render buffers to %d x %d lines", s_band_slots, lines);
+            s_band_ready = false;
+            return;
+        }
+    }
+
+#if SUPPORT_ESP_ASYNC_PRESENT
+    if (s_present_task) {
+        int bands = 0;
+        for (int y = 0; y < s_screen_height; y += lines) {
+            for (int x = 0; x < s_screen_width; x += s_tile_width, bands++) {
+                int slot = 0;
+                xQueueReceive(s_free_queue, &slot, portMAX_DELAY);
+
+                ESP_PROFILE_BEGIN(RAYLIB_ESP_PHASE_REPLAY);
+                EspListReplay((EspRect){ x, y, s_tile_width, lines }, slot * lines);
+                ESP_PROFILE_END(RAYLIB_ESP_PHASE_REPLAY);
+                s_band_rects[slot] = BandRect(x, y);
+                xQueueSend(s_present_queue, &slot, portMAX_DELAY);
+            }
+        }
+
+        // Barrier: the slots live in the rlsw buffer, which must not change under the present task
+        raylib_esp_wait_present();
+
+        s_present_stats.frame++;
+        s_present_stats.rects = bands;
+        s_present_stats.pixels = s_screen_width * s_screen_height;
+        return;
+    }
+#endif
+
+    if (s_flush_mutex) {
+        xSemaphoreTake(s_flush_mutex, portMAX_DELAY);
+    }
+
+    int bands = 0;
+    for (int y = 0; y < s_screen_height; y += lines) {
+        for (int x = 0; x < s_screen_width; x += s_tile_width, bands++) {
+            ESP_PROFILE_BEGIN(RAYLIB_ESP_PHASE_REPLAY);
+            EspListReplay((EspRect){ x, y, s_tile_width, lines }, 0);
+            ESP_PROFILE_END(RAYLIB_ESP_PHASE_REPLAY);
+            s_band_rects[0] = BandRect(x, y);
+            FlushBand(0);
+        }
+    }
+    if (EspPanelAttached()) EspPanelFrameEnd();
+
+    if (s_flush_mutex) {
+        xSemaphoreGive(s_flush_mutex);
+    }
+
+    s_present_stats.frame++;
+    s_present_stats.rects = bands;
+    s_present_stats.pixels = s_screen_width * s_screen_height;
+}
+#endif
+
+static void PresentFrame(void)
+{
+#if SUPPORT_ESP_BAND_RENDER
+    if (EspBandLines() > 0) {
+        PresentBands();
+        return;
+    }
+#endif
+
+    if ((!s_framebuffers[0] && !PresentInPlace()) || (!s_display_flush && !EspPanelAttached())) {
         ESP_LOGE("RAYLIB", "Framebuffer or flush callback not set!");
         return;
     }
@@ -106,22 +729,113 @@ void SwapScreenBuffer(void)
         return;
     }
 
-    // Vertical flip for LCD coordinate system
-    for (int row = 0; row < s_screen_height; row++) {
-        int src_row = s_screen_height - 1 - row;
-        memcpy(s_framebuffer + (row * s_screen_width),
-               sw_buf + (src_row * s_screen_width),
-               s_screen_width * sizeof(uint16_t));
+    PresentJob job;
+    CollectPresentRects(&job, sw_buf);
+    if (job.count == 0) return;     // Nothing changed since the last frame
+
+#if SUPPORT_ESP_ASYNC_PRESENT
+    if (s_present_task) {
+        // Wait for a free present buffer, fill it and queue it, the flush runs on the present task
+        int index = 0;
+        xQueueReceive(s_free_queue, &index, portMAX_DELAY);
+        s_present_jobs[index] = job;
+        CopyJob(s_framebuffers[index], sw_buf, &job);
+        xQueueSend(s_present_queue, &index, portMAX_DELAY);
+        return;
     }
+#endif
 
-    // Thread-safe flush
-    if (s_flush_mutex) {
-        xSemaphoreTake(s_flush_mutex, portMAX_DELAY);
+    s_present_jobs[0] = job;
+
+    if (PresentInPlace()) {
+        FlushJob(sw_buf, &s_present_jobs[0], false);
+        return;
     }
-    s_display_flush(s_framebuffer, 0, 0, s_screen_width, s_screen_height);
-    if (s_flush_mutex) {
-        xSemaphoreGive(s_flush_mutex);
+
+    // Vertical flip for LCD coordinate system
+    CopyJob(s_framebuffers[0], sw_buf, &s_present_jobs[0]);
+
+    FlushJob(s_framebuffers[0], &s_present_jobs[0], true);
+}
+
+//----------------------------------------------------------------------------------
+// Frame clock
+//----------------------------------------------------------------------------------
+
+static void FrameTimerCallback(void *arg)
+{
+    xSemaphoreGive(s_frame_wake);
+}
+
+// Block the calling task until deadline (esp_timer time), waits within the jitter tolerance are skipped
+static void SleepUntil(int64_t deadline)
+{
+    int64_t remaining = deadline - esp_timer_get_time();
+    if (remaining <= (int64_t)s_present_config.frame_tolerance_us) return;
+
+    if (s_frame_timer && (esp_timer_start_once(s_frame_timer, (uint64_t)remaining) == ESP_OK)) {
+        xSemaphoreTake(s_frame_wake, portMAX_DELAY);
+        return;
     }
+
+    // Before InitWindow(): tick resolution
+    TickType_t ticks = pdMS_TO_TICKS(remaining/1000);
+    vTaskDelay((ticks > 0)? ticks : 1);
+}
+
+// Hold the frame until its SetTargetFPS() deadline, a late frame restarts the schedule from now
+static void FramePace(void)
+{
+    s_present_stats.frame_wait_us = 0;
+    if (s_frame_period_us == 0) return;
+
+    int64_t now = esp_timer_get_time();
+    s_frame_deadline = (s_frame_deadline == 0)? now + s_frame_period_us : s_frame_deadline + s_frame_period_us;
+
+    int64_t late = now - s_frame_deadline;
+    if (late > (int64_t)s_present_config.frame_tolerance_us) {
+        s_present_stats.deadline_misses++;
+        if (late > s_present_stats.worst_late_us) s_present_stats.worst_late_us = (int32_t)late;
+        s_frame_deadline = now;
+        return;
+    }
+
+    SleepUntil(s_frame_deadline);
+    s_present_stats.frame_wait_us = (int32_t)(esp_timer_get_time() - now);
+}
+
+// Frame profiler: the frame and draw phases begin in BeginDrawing() (rlgl_esp_idf.c)
+void SwapScreenBuffer(void)
+{
+    ESP_PROFILE_END(RAYLIB_ESP_PHASE_DRAW);
+    ESP_RENDER_STATS(EspStatsFrameEnd());
+    ESP_TRACE_BEGIN(ESP_TRACE_SWAP);
+    PresentFrame();
+
+    ESP_PROFILE_BEGIN(RAYLIB_ESP_PHASE_PACE);
+    FramePace();
+    ESP_PROFILE_END(RAYLIB_ESP_PHASE_PACE);
+    ESP_TRACE_END(ESP_TRACE_SWAP);
+
+    ESP_PROFILE_END(RAYLIB_ESP_PHASE_FRAME);
+    ESP_PROFILE_FRAME();
+}
+
+// rcore EndDrawing() only waits out what is left of the target frame time, and its WaitTime()
+// has no sleep on this platform: pacing happens in SwapScreenBuffer() instead
+void __wrap_SetTargetFPS(int fps)
+{
+    __real_SetTargetFPS(fps);
+
+    s_frame_period_us = (fps > 0)? (1000000/fps) : 0;
+    s_frame_deadline = 0;
+}
+
+void __wrap_WaitTime(double seconds)
+{
+    if (seconds <= 0.0) return;
+
+    SleepUntil(esp_timer_get_time() + (int64_t)(seconds*1000000.0));
 }
 
 //----------------------------------------------------------------------------------
@@ -171,7 +885,7 @@ void DisableCursor(void) { }
 
 double GetTime(void)
 {
-    return 0;
+    return (double)(esp_timer_get_time() - s_time_base)/1000000.0;
 }
 
 void OpenURL(const char *url)
@@ -187,36 +901,73 @@ int SetGamepadMappings(const char *mappings) { return 0; }
 void SetMousePosition(int x, int y) { }
 void SetMouseCursor(int cursor) { TRACELOG(LOG_WARNING, "SetMouseCursor() not implemented"); }
 const char *GetKeyName(int key) { return ""; }
-void PollInputEvents(void) { }
+// No input devices on this platform, the call is only marked on the trace timeline
+void PollInputEvents(void)
+{
+    ESP_TRACE_MARK(ESP_TRACE_POLL_INPUT);
+}
 
 //----------------------------------------------------------------------------------
 // Platform Internal Functions
 //----------------------------------------------------------------------------------
 
-static bool CreateWindowFramebuffer(int width, int height)
+static bool CreateWindowFramebuffer(int width, int height, int count)
 {
     s_screen_width = width;
     s_screen_height = height;
 
-    // Allocate RGB565 framebuffer (prefer PSRAM)
-    s_framebuffer = heap_caps_malloc(width * height * sizeof(uint16_t), MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
-    if (!s_framebuffer) {
-        s_framebuffer = heap_caps_malloc(width * height * sizeof(uint16_t), MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    for (int i = 0; i < count; i++) {
+        // Allocate RGB565 framebuffer (prefer PSRAM)
+        uint16_t *buf = heap_caps_malloc(width * height * sizeof(uint16_t), MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+        if (!buf) {
+            buf = heap_caps_malloc(width * height * sizeof(uint16_t), MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+        }
+
+        if (!buf) {
+            TRACELOG(LOG_ERROR, "PLATFORM: Failed to allocate framebuffer %d", i);
+            return false;
+        }
+
+        // Init to green
+        for (int p = 0; p < width * height; p++) {
+            buf[p] = 0x07E0;  // RGB565 green
+        }
+
+        s_framebuffers[i] = buf;
+        s_framebuffer_count = i + 1;
     }
 
-    if (!s_framebuffer) {
-        TRACELOG(LOG_ERROR, "PLATFORM: Failed to allocate framebuffer");
+    TRACELOG(LOG_INFO, "PLATFORM: Framebuffer allocated: %dx%d (x%d)", width, height, count);
+    return true;
+}
+
+#if SUPPORT_ESP_ASYNC_PRESENT
+// Present task cycling depth framebuffers (or band slots) between renderer and display
+static bool CreatePresentTask(int depth)
+{
+    s_present_queue = xQueueCreate(depth, sizeof(int));
+    s_free_queue = xQueueCreate(depth, sizeof(int));
+    if (!s_present_queue || !s_free_queue) {
+        TRACELOG(LOG_ERROR, "PLATFORM: Failed to create present queues");
         return false;
     }
 
-    // Init to green
-    for (int i = 0; i < width * height; i++) {
-        s_framebuffer[i] = 0x07E0;  // RGB565 green
+    for (int i = 0; i < depth; i++) {
+        xQueueSend(s_free_queue, &i, 0);
     }
+    s_present_depth = depth;
 
-    TRACELOG(LOG_INFO, "PLATFORM: Framebuffer allocated: %dx%d", width, height);
+    if (xTaskCreatePinnedToCore(PresentTask, "raylib_present", s_present_config.task_stack_size, NULL,
+                                s_present_config.task_priority, &s_present_task, s_present_config.core_id) != pdPASS) {
+        TRACELOG(LOG_ERROR, "PLATFORM: Failed to create present task");
+        s_present_task = NULL;
+        return false;
+    }
+
+    TRACELOG(LOG_INFO, "PLATFORM: Async present enabled (depth %d, core %d)", depth, s_present_config.core_id);
     return true;
 }
+#endif
 
 int InitPlatform(void)
 {
@@ -225,6 +976,11 @@ int InitPlatform(void)
         return -1;
     }
 
+    s_time_base = esp_timer_get_time();
+#if SUPPORT_ESP_PROFILER
+    EspProfileReset();
+#endif
+
     uint16_t width, height;
     s_get_dimensions(&width, &height);
 
@@ -233,23 +989,199 @@ int InitPlatform(void)
         return -1;
     }
 
-    if (!CreateWindowFramebuffer(width, height)) {
+#if SUPPORT_ESP_BAND_RENDER
+    if (s_present_config.band_lines > 0) {
+        if (s_present_config.top_down || (s_present_config.mode != RAYLIB_ESP_PRESENT_FULL)) {
+            TRACELOG(LOG_WARNING, "PLATFORM: Band render mode presents full frames, ignoring top_down and mode");
+            s_present_config.top_down = false;
+            s_present_config.mode = RAYLIB_ESP_PRESENT_FULL;
+        }
+        if (s_present_config.band_lines > height) s_present_config.band_lines = height;
+
+        // Tiles narrower than the screen, kept even for the pixel kernels
+        s_tile_width = s_present_config.tile_width & ~1;
+        if ((s_tile_width <= 0) || (s_tile_width > width)) s_tile_width = width;
+    }
+#else
+    s_present_config.band_lines = 0;
+#endif
+
+    // Scanout reads the rlsw color buffer until the next frame is presented
+    if (EspPanelScanout() && (s_present_config.async || (s_present_config.band_lines > 0) || (s_present_config.mode != RAYLIB_ESP_PRESENT_FULL))) {
+        TRACELOG(LOG_WARNING, "PLATFORM: RGB bounce scanout presents full frames in place, ignoring async, band_lines and mode");
+        s_present_config.async = false;
+        s_present_config.band_lines = 0;
+        s_present_config.mode = RAYLIB_ESP_PRESENT_FULL;
+    }
+
+    int count = (PresentInPlace() || (s_present_config.band_lines > 0))? 0 : 1;
+    int depth = 0;
+#if SUPPORT_ESP_ASYNC_PRESENT
+    if (s_present_config.async) {
+        depth = s_present_config.queue_depth;
+        if (depth < 1) depth = 1;
+        if (depth > ESP_PRESENT_MAX_QUEUE_DEPTH) depth = ESP_PRESENT_MAX_QUEUE_DEPTH;
+        if (s_present_config.band_lines == 0) count = depth;
+    }
+#endif
+#if SUPPORT_ESP_BAND_RENDER
+    // Async band mode: the band being sent and the one being rasterized need their own slot
+    if ((s_present_config.band_lines > 0) && s_present_config.async) {
+        if (depth < 2) depth = 2;
+        s_band_slots = depth;
+    }
+#endif
+
+    if (!CreateWindowFramebuffer(width, height, count)) {
         return -1;
     }
 
     // Create flush mutex
     s_flush_mutex = xSemaphoreCreateMutex();
 
+    if (!EspPanelInit(width, height)) {
+        return -1;
+    }
+
+    // Other panel frame buffers hold older frames, partial presents would leave them stale
+    if ((EspPanelFrameBufferCount() > 1) && (s_present_config.mode != RAYLIB_ESP_PRESENT_FULL)) {
+        TRACELOG(LOG_WARNING, "PLATFORM: Multiple RGB panel frame buffers, presenting full frames");
+        s_present_config.mode = RAYLIB_ESP_PRESENT_FULL;
+    }
+
+#if SUPPORT_ESP_BAND_RENDER
+    if ((s_present_config.band_lines > 0) && !EspPanelAttached()) {
+        s_band_staging = heap_caps_malloc(s_tile_width * s_present_config.band_lines * sizeof(uint16_t), MALLOC_CAP_DMA | MALLOC_CAP_INTERNAL);
+        if (!s_band_staging) {
+            TRACELOG(LOG_ERROR, "PLATFORM: Failed to allocate band buffer (%d lines)", s_present_config.band_lines);
+            return -1;
+        }
+    }
+    if (s_present_config.band_lines > 0) {
+        TRACELOG(LOG_INFO, "PLATFORM: Band render mode (%dx%d tiles, %d in flight)", s_tile_width, s_present_config.band_lines, s_band_slots);
+    }
+#endif
+
+#if SUPPORT_ESP_TILE_DIFF
+    if (s_present_config.mode == RAYLIB_ESP_PRESENT_TILE_DIFF) {
+        s_tiles_x = (width + ESP_TILE_WIDTH - 1) / ESP_TILE_WIDTH;
+        s_tiles_y = (height + ESP_TILE_HEIGHT - 1) / ESP_TILE_HEIGHT;
+        s_tile_hashes = heap_caps_calloc(s_tiles_x * s_tiles_y, sizeof(uint32_t), MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+        if (!s_tile_hashes) {
+            TRACELOG(LOG_ERROR, "PLATFORM: Failed to allocate tile hashes");
+            return -1;
+        }
+    }
+#endif
+
+#if SUPPORT_ESP_ASYNC_PRESENT
+    if (s_present_config.async && !CreatePresentTask(depth)) {
+        return -1;
+    }
+#endif
+
+    // Frame pacing wakes up from an esp_timer instead of the tick, which is usually 10 ms
+    const esp_timer_create_args_t timer_args = { .callback = FrameTimerCallback, .name = "raylib_frame" };
+    s_frame_wake = xSemaphoreCreateBinary();
+    if (!s_frame_wake || (esp_timer_create(&timer_args, &s_frame_timer) != ESP_OK)) {
+        TRACELOG(LOG_WARNING, "PLATFORM: Failed to create frame timer, pacing at tick resolution");
+        s_frame_timer = NULL;
+    }
+
+    if (s_present_config.lazy_redraw) {
+        s_redraw_event = xSemaphoreCreateBinary();
+        if (!s_redraw_event) {
+            TRACELOG(LOG_ERROR, "PLATFORM: Failed to create redraw event");
+            return -1;
+        }
+        xSemaphoreGive(s_redraw_event);     // First frame is always drawn
+
+#if CONFIG_PM_ENABLE
+        if (esp_pm_lock_create(ESP_PM_NO_LIGHT_SLEEP, 0, "raylib_frame", &s_frame_pm_lock) == ESP_OK) {
+            esp_pm_lock_acquire(s_frame_pm_lock);
+        } else {
+            s_frame_pm_lock = NULL;
+        }
+#endif
+    }
+
     TRACELOG(LOG_INFO, "PLATFORM: ESP-IDF initialized (%dx%d)", width, height);
     return 0;
 }
 
 void ClosePlatform(void)
 {
-    if (s_framebuffer) {
-        heap_caps_free(s_framebuffer);
-        s_framebuffer = NULL;
+    if (s_frame_timer) {
+        esp_timer_stop(s_frame_timer);
+        esp_timer_delete(s_frame_timer);
+        s_frame_timer = NULL;
+    }
+    if (s_frame_wake) {
+        vSemaphoreDelete(s_frame_wake);
+        s_frame_wake = NULL;
+    }
+    if (s_redraw_event) {
+        vSemaphoreDelete(s_redraw_event);
+        s_redraw_event = NULL;
+    }
+#if CONFIG_PM_ENABLE
+    if (s_frame_pm_lock) {
+        esp_pm_lock_release(s_frame_pm_lock);
+        esp_pm_lock_delete(s_frame_pm_lock);
+        s_frame_pm_lock = NULL;
+    }
+#endif
+    s_frame_deadline = 0;
+
+#if SUPPORT_ESP_ASYNC_PRESENT
+    if (s_present_task) {
+        // Drain in-flight frames, then ask the present task to exit
+        raylib_esp_wait_present();
+        int stop = -1;
+        s_present_closer = xTaskGetCurrentTaskHandle();
+        xQueueSend(s_present_queue, &stop, portMAX_DELAY);
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        s_present_task = NULL;
+    }
+    if (s_present_queue) {
+        vQueueDelete(s_present_queue);
+        s_present_queue = NULL;
+    }
+    if (s_free_queue) {
+        vQueueDelete(s_free_queue);
+        s_free_queue = NULL;
+    }
+    s_present_depth = 0;
+#endif
+
+    EspPanelClose();
+    EspTextureClose();
+    EspGlyphCacheClose();
+    ESP_RENDER_STATS(EspStatsClose());
+
+#if SUPPORT_ESP_BAND_RENDER
+    if (s_band_staging) {
+        heap_caps_free(s_band_staging);
+        s_band_staging = NULL;
+    }
+    s_band_ready = false;
+    s_band_buffer = NULL;
+    s_band_slots = 1;
+    EspListClose();
+#endif
+
+#if SUPPORT_ESP_TILE_DIFF
+    if (s_tile_hashes) {
+        heap_caps_free(s_tile_hashes);
+        s_tile_hashes = NULL;
+    }
+#endif
+
+    for (int i = 0; i < s_framebuffer_count; i++) {
+        heap_caps_free(s_framebuffers[i]);
+        s_framebuffers[i] = NULL;
     }
+    s_framebuffer_count = 0;
 
     if (s_flush_mutex) {
         vSemaphoreDelete(s_flush_mutex);
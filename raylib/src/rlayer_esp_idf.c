@@ -0,0 +1,122 @@
+/**********************************************************************************************
+*
+*   rlayer_esp_idf - Retained layers for ESP-IDF
+*
+*   A layer is an opaque screen rectangle whose content is drawn once with regular raylib
+*   calls and kept as an RGB565 surface. raylib_esp_layer_begin() returns true when the layer
+*   must be (re)drawn: the rectangle is cleared to the layer background and clipped with a
+*   scissor, and raylib_esp_layer_end() copies the rasterized pixels into the surface. On
+*   later frames raylib_esp_layer_begin() copies the surface back with row copies and returns
+*   false, until raylib_esp_layer_invalidate() is called
+*
+*   Layers need the screen color buffer: in band render mode and inside render textures the
+*   layer content is drawn every frame instead
+*
+**********************************************************************************************/
+
+#include "config.h"
+#include "raylib.h"
+#include "rlgl.h"
+#include "esp_idf_internal.h"
+#include "raylib_esp.h"
+
+#include "esp_heap_caps.h"
+
+//----------------------------------------------------------------------------------
+// Types and Structures
+//----------------------------------------------------------------------------------
+struct raylib_esp_layer {
+    EspRect rect;
+    Color background;
+    uint16_t *pixels;           // rect.width*rect.height, top row first
+    bool valid;                 // pixels hold the current content
+    bool drawing;               // Between a begin returning true and end
+};
+
+//----------------------------------------------------------------------------------
+// Module Internal Functions
+//----------------------------------------------------------------------------------
+
+static uint16_t *LayerRow(uint16_t *buf, int bufWidth, int bufHeight, int x, int y)
+{
+    return buf + ((EspTopDownEnabled()? y : bufHeight - 1 - y) * bufWidth) + x;
+}
+
+//----------------------------------------------------------------------------------
+// Public API
+//----------------------------------------------------------------------------------
+
+raylib_esp_layer_t *raylib_esp_layer_create(int x, int y, int width, int height, Color background)
+{
+    if ((width <= 0) || (height <= 0)) return NULL;
+
+    raylib_esp_layer_t *layer = heap_caps_calloc(1, sizeof(raylib_esp_layer_t), MALLOC_CAP_DEFAULT);
+    if (!layer) return NULL;
+
+    layer->rect = (EspRect){ x, y, width, height };
+    layer->background = background;
+    layer->pixels = heap_caps_malloc(width*height*sizeof(uint16_t), MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+    if (!layer->pixels) TRACELOG(LOG_WARNING, "LAYER: Failed to allocate %d x %d surface, layer drawn every frame", width, height);
+
+    return layer;
+}
+
+void raylib_esp_layer_destroy(raylib_esp_layer_t *layer)
+{
+    if (!layer) return;
+
+    heap_caps_free(layer->pixels);
+    heap_caps_free(layer);
+}
+
+void raylib_esp_layer_invalidate(raylib_esp_layer_t *layer)
+{
+    if (!layer) return;
+
+    layer->valid = false;
+    raylib_esp_request_redraw();
+}
+
+bool raylib_esp_layer_begin(raylib_esp_layer_t *layer)
+{
+    if (!layer) return false;
+
+    int bufWidth = 0, bufHeight = 0;
+    uint16_t *buf = EspScreenTarget(&bufWidth, &bufHeight);
+    EspRect r = layer->rect;
+    bool onScreen = (r.x >= 0) && (r.y >= 0) && (r.x + r.width <= bufWidth) && (r.y + r.height <= bufHeight);
+
+    // Composite the retained content
+    if (buf && onScreen && layer->valid) {
+        for (int row = 0; row < r.height; row++) {
+            EspPixelCopy(LayerRow(buf, bufWidth, bufHeight, r.x, r.y + row), layer->pixels + row*r.width, r.width);
+        }
+        if (EspDamageEnabled()) EspDamageAdd(r.x, r.y, r.width, r.height);
+        return false;
+    }
+
+    BeginScissorMode(r.x, r.y, r.width, r.height);
+    DrawRectangle(r.x, r.y, r.width, r.height, layer->background);
+    layer->drawing = true;
+
+    return true;
+}
+
+void raylib_esp_layer_end(raylib_esp_layer_t *layer)
+{
+    if (!layer || !layer->drawing) return;
+
+    EndScissorMode();
+    layer->drawing = false;
+
+    int bufWidth = 0, bufHeight = 0;
+    uint16_t *buf = EspScreenTarget(&bufWidth, &bufHeight);
+    EspRect r = layer->rect;
+    if (!buf || !layer->pixels || (r.x < 0) || (r.y < 0) || (r.x + r.width > bufWidth) || (r.y + r.height > bufHeight)) return;
+
+    // rlsw rasterizes each primitive as it is submitted, the color buffer holds the layer now
+    for (int row = 0; row < r.height; row++) {
+        EspPixelCopy(layer->pixels + row*r.width, LayerRow(buf, bufWidth, bufHeight, r.x, r.y + row), r.width);
+    }
+    layer->valid = true;
+}
@@ -0,0 +1,1131 @@
+/**********************************************************************************************
+*
+*   rlgl_esp_idf - rlgl interposition layer for ESP-IDF
+*
+*   rshapes, rtextures and rtext reach rlgl (compiled into rcore.c) through external calls,
+*   and applications reach rcore the same way. CMakeLists.txt links those symbols with
+*   -Wl,--wrap so the platform layer can observe draw calls without patching upstream raylib:
+*   every __wrap_X() below forwards to __real_X()
+*
+*   Calls made inside rcore.c itself (e.g. BeginDrawing() -> rlLoadIdentity()) are not
+*   interposed, the wrappers of the public entry points account for them instead
+*
+*   In band render mode screen draw calls are recorded into the display list (rlist_esp_idf.c)
+*   instead of being forwarded, and replayed once per band at present time
+*
+*   Screen-aligned solid rectangles and screen clears skip rlsw triangle setup altogether and
+*   are filled straight into the color buffer with span kernels (rpixel_esp_idf.c), unscaled
+*   texture draws are copied row by row from their RGB565 shadows (rtexture_esp_idf.c), and
+*   text is blitted from cached glyph masks (rtext_esp_idf.c)
+*
+**********************************************************************************************/
+
+#include "config.h"
+#include "raylib.h"
+#include "rlgl.h"
+#include "esp_idf_internal.h"
+#include "raylib_esp.h"
+
+#include <math.h>
+
+#if SUPPORT_ESP_FAST_RECT_BENCHMARK
+    #include "esp_timer.h"
+#endif
+
+//----------------------------------------------------------------------------------
+// Real implementations (resolved by the linker)
+//----------------------------------------------------------------------------------
+void __real_rlBegin(int mode);
+void __real_rlEnd(void);
+void __real_rlVertex2i(int x, int y);
+void __real_rlVertex2f(float x, float y);
+void __real_rlVertex3f(float x, float y, float z);
+void __real_rlTexCoord2f(float x, float y);
+void __real_rlNormal3f(float x, float y, float z);
+void __real_rlColor4ub(unsigned char r, unsigned char g, unsigned char b, unsigned char a);
+void __real_rlColor4f(float x, float y, float z, float w);
+void __real_rlColor3f(float x, float y, float z);
+void __real_rlSetTexture(unsigned int id);
+void __real_rlMatrixMode(int mode);
+void __real_rlPushMatrix(void);
+void __real_rlPopMatrix(void);
+void __real_rlLoadIdentity(void);
+void __real_rlTranslatef(float x, float y, float z);
+void __real_rlRotatef(float angle, float x, float y, float z);
+void __real_rlScalef(float x, float y, float z);
+void __real_rlMultMatrixf(const float *matf);
+
+void __real_BeginDrawing(void);
+void __real_ClearBackground(Color color);
+void __real_BeginMode2D(Camera2D camera);
+void __real_EndMode2D(void);
+void __real_BeginTextureMode(RenderTexture2D target);
+void __real_EndTextureMode(void);
+void __real_BeginScissorMode(int x, int y, int width, int height);
+void __real_EndScissorMode(void);
+void __real_BeginBlendMode(int mode);
+void __real_EndBlendMode(void);
+void __real_BeginMode3D(Camera3D camera);
+void __real_EndMode3D(void);
+
+void __real_DrawRectangle(int posX, int posY, int width, int height, Color color);
+void __real_DrawRectangleV(Vector2 position, Vector2 size, Color color);
+void __real_DrawRectangleRec(Rectangle rec, Color color);
+
+void __real_DrawTexture(Texture2D texture, int posX, int posY, Color tint);
+void __real_DrawTextureV(Texture2D texture, Vector2 position, Color tint);
+void __real_DrawTextureEx(Texture2D texture, Vector2 position, float rotation, float scale, Color tint);
+void __real_DrawTextureRec(Texture2D texture, Rectangle source, Vector2 position, Color tint);
+
+void __real_DrawText(const char *text, int posX, int posY, int fontSize, Color color);
+void __real_DrawTextEx(Font font, const char *text, Vector2 position, float fontSize, float spacing, Color tint);
+void __real_SetTextLineSpacing(int spacing);
+
+// External software renderer API
+extern void *swGetColorBuffer(int *width, int *height);
+extern void swClear(uint32_t bitmask);
+
+#define SW_DEPTH_BUFFER_BIT 0x00000100  // GL_DEPTH_BUFFER_BIT, rlsw uses the GL values
+
+//----------------------------------------------------------------------------------
+// Types and Structures
+//----------------------------------------------------------------------------------
+
+// 2D affine transform mirroring the rlgl modelview matrix: p' = (a*x + c*y + e, b*x + d*y + f)
+typedef struct {
+    float a, b, c, d, e, f;
+    bool affine;                // false once a transform outside the XY plane was applied
+} Transform2D;
+
+typedef struct {
+    Transform2D stack[RL_MAX_MATRIX_STACK_SIZE];
+    int depth;
+    Transform2D current;
+    bool modelview;             // rlMatrixMode() target is the modelview matrix
+    bool projectionChanged;     // Application touched the projection this frame
+    bool textureMode;           // Drawing into a render texture, not the screen
+    bool mode3D;                // Between BeginMode3D() and EndMode3D()
+    int blendMode;
+    bool scissor;
+    EspRect scissorRect;
+    int textLineSpacing;        // Mirrors rtext SetTextLineSpacing()
+} InterposeState;
+
+typedef struct {
+    float minX, minY, maxX, maxY;
+    bool active;
+} PrimitiveBounds;
+
+//----------------------------------------------------------------------------------
+// Global Variables Definition
+//----------------------------------------------------------------------------------
+static const Transform2D IDENTITY = { 1.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, true };
+
+static InterposeState state = { .current = { 1.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, true }, .modelview = true, .blendMode = BLEND_ALPHA, .textLineSpacing = 2 };
+static PrimitiveBounds bounds = { 0 };
+
+//----------------------------------------------------------------------------------
+// Transform helpers
+//----------------------------------------------------------------------------------
+
+// Post-multiply (GL convention): M = M*N
+static void TransformMultiply(Transform2D *m, const Transform2D *n)
+{
+    Transform2D r;
+    r.a = m->a*n->a + m->c*n->b;
+    r.b = m->b*n->a + m->d*n->b;
+    r.c = m->a*n->c + m->c*n->d;
+    r.d = m->b*n->c + m->d*n->d;
+    r.e = m->a*n->e + m->c*n->f + m->e;
+    r.f = m->b*n->e + m->d*n->f + m->f;
+    r.affine = m->affine && n->affine;
+    *m = r;
+}
+
+// Column-major 4x4 matrix to 2D affine, flags matrices that are not plain XY transforms
+static Transform2D TransformFromMatrix(const float *m)
+{
+    Transform2D t = { m[0], m[1], m[4], m[5], m[12], m[13], true };
+
+    if ((m[2] != 0.0f) || (m[6] != 0.0f) || (m[3] != 0.0f) || (m[7] != 0.0f) ||
+        (m[8] != 0.0f) || (m[9] != 0.0f) || (m[15] != 1.0f)) t.affine = false;
+
+    return t;
+}
+
+static void TransformPoint(const Transform2D *m, float x, float y, float *outX, float *outY)
+{
+    *outX = m->a*x + m->c*y + m->e;
+    *outY = m->b*x + m->d*y + m->f;
+}
+
+//----------------------------------------------------------------------------------
+// Damage and display list helpers
+//----------------------------------------------------------------------------------
+
+static void BoundsAdd(float x, float y)
+{
+    if (!bounds.active) return;
+
+    if (x < bounds.minX) bounds.minX = x;
+    if (y < bounds.minY) bounds.minY = y;
+    if (x > bounds.maxX) bounds.maxX = x;
+    if (y > bounds.maxY) bounds.maxY = y;
+}
+
+// Screen draws are recorded for band replay instead of rasterized right away
+static bool Recording(void)
+{
+    return !state.textureMode && EspListRecording();
+}
+
+// Screen rectangle covered by the finished primitive, false if it covers nothing
+static bool BoundsResolve(EspRect *rect)
+{
+    if (bounds.minX > bounds.maxX) return false;
+
+    if (state.projectionChanged || !state.current.affine) {
+        *rect = (EspRect){ 0, 0, GetScreenWidth(), GetScreenHeight() };
+        return true;
+    }
+
+    // Transform the four corners, rotation may swap extents
+    float xs[4], ys[4];
+    TransformPoint(&state.current, bounds.minX, bounds.minY, &xs[0], &ys[0]);
+    TransformPoint(&state.current, bounds.maxX, bounds.minY, &xs[1], &ys[1]);
+    TransformPoint(&state.current, bounds.minX, bounds.maxY, &xs[2], &ys[2]);
+    TransformPoint(&state.current, bounds.maxX, bounds.maxY, &xs[3], &ys[3]);
+
+    float minX = xs[0], maxX = xs[0], minY = ys[0], maxY = ys[0];
+    for (int i = 1; i < 4; i++) {
+        minX = fminf(minX, xs[i]); maxX = fmaxf(maxX, xs[i]);
+        minY = fminf(minY, ys[i]); maxY = fmaxf(maxY, ys[i]);
+    }
+
+    // One pixel of margin covers line width and rasterizer rounding
+    int x0 = (int)floorf(minX) - 1;
+    int y0 = (int)floorf(minY) - 1;
+    int x1 = (int)ceilf(maxX) + 1;
+    int y1 = (int)ceilf(maxY) + 1;
+
+    if (state.scissor) {
+        if (x0 < state.scissorRect.x) x0 = state.scissorRect.x;
+        if (y0 < state.scissorRect.y) y0 = state.scissorRect.y;
+        if (x1 > state.scissorRect.x + state.scissorRect.width) x1 = state.scissorRect.x + state.scissorRect.width;
+        if (y1 > state.scissorRect.y + state.scissorRect.height) y1 = state.scissorRect.y + state.scissorRect.height;
+    }
+
+    if ((x1 <= x0) || (y1 <= y0)) return false;
+
+    *rect = (EspRect){ x0, y0, x1 - x0, y1 - y0 };
+    return true;
+}
+
+// Convert the finished primitive bounds into screen damage and display list bounds
+static void BoundsCommit(void)
+{
+    bounds.active = false;
+
+    if (state.textureMode) return;
+
+    EspRect rect = { 0 };
+    bool visible = BoundsResolve(&rect);
+
+    if (EspListRecording()) EspListEndPrimitive(visible, rect);
+    if (visible && EspDamageEnabled()) EspDamageAdd(rect.x, rect.y, rect.width, rect.height);
+}
+
+//----------------------------------------------------------------------------------
+// Rectangle fast path
+//----------------------------------------------------------------------------------
+
+// rlsw color buffer when drawing to the screen (not into a render texture or a band display list)
+uint16_t *EspScreenTarget(int *width, int *height)
+{
+    if (Recording() || state.textureMode) return NULL;
+
+    uint16_t *buf = (uint16_t *)swGetColorBuffer(width, height);
+    if (!buf || (*width != GetScreenWidth()) || (*height != GetScreenHeight())) return NULL;
+
+    return buf;
+}
+
+// rlsw color buffer when drawing straight to the screen with the default projection, NULL otherwise
+static uint16_t *ScreenBuffer(int *width, int *height)
+{
+    if (state.mode3D || state.projectionChanged) return NULL;
+
+    return EspScreenTarget(width, height);
+}
+
+static uint16_t ColorTo565(Color color)
+{
+    return (uint16_t)(((color.r >> 3) << 11) | ((color.g >> 2) << 5) | (color.b >> 3));
+}
+
+// Modelview is a plain translation (no rotation or scale)
+static bool TranslationOnly(void)
+{
+    const Transform2D *m = &state.current;
+    return m->affine && (m->a == 1.0f) && (m->b == 0.0f) && (m->c == 0.0f) && (m->d == 1.0f);
+}
+
+// Clip a screen span rectangle to the scissor and the color buffer, false if nothing is left
+static bool ClipToScreen(int *x0, int *y0, int *x1, int *y1, int bufWidth, int bufHeight)
+{
+    EspRect clip = state.scissor? state.scissorRect : (EspRect){ 0, 0, bufWidth, bufHeight };
+    if (clip.x < 0) { clip.width += clip.x; clip.x = 0; }
+    if (clip.y < 0) { clip.height += clip.y; clip.y = 0; }
+    if (*x0 < clip.x) *x0 = clip.x;
+    if (*y0 < clip.y) *y0 = clip.y;
+    if (*x1 > clip.x + clip.width) *x1 = clip.x + clip.width;
+    if (*y1 > clip.y + clip.height) *y1 = clip.y + clip.height;
+    if (*x1 > bufWidth) *x1 = bufWidth;
+    if (*y1 > bufHeight) *y1 = bufHeight;
+
+    return (*x1 > *x0) && (*y1 > *y0);
+}
+
+#if SUPPORT_ESP_RENDER_STATS
+// Start counting a primitive, with fragments only when its vertices map to the screen through
+// the mirrored modelview (not in render textures, 3D mode or with a custom projection)
+static void StatsBegin(int mode)
+{
+    int width = GetScreenWidth(), height = GetScreenHeight();
+    int x0 = 0, y0 = 0, x1 = width, y1 = height;
+    bool screenSpace = !state.textureMode && !state.mode3D && !state.projectionChanged && state.current.affine;
+
+    if (!ClipToScreen(&x0, &y0, &x1, &y1, width, height)) x1 = x0;
+    EspStatsBegin(mode, screenSpace, (EspRect){ x0, y0, x1 - x0, y1 - y0 });
+}
+
+static void StatsVertex(float x, float y)
+{
+    float sx = 0.0f, sy = 0.0f;
+    TransformPoint(&state.current, x, y, &sx, &sy);
+    EspStatsVertex(sx, sy);
+}
+#endif
+
+// Fill a solid rectangle with span writes, false if the general path must draw it
+// (rotated or scaled modelview, custom projection, blend modes other than alpha)
+static bool FastRect(float x, float y, float width, float height, Color color)
+{
+#if SUPPORT_ESP_FAST_RECT
+    if (!TranslationOnly() || (state.blendMode != BLEND_ALPHA) || (width <= 0.0f) || (height <= 0.0f)) return false;
+
+    int bufWidth = 0, bufHeight = 0;
+    uint16_t *buf = ScreenBuffer(&bufWidth, &bufHeight);
+    if (!buf) return false;
+
+    // Pixels whose centers fall inside the rectangle, as the rasterizer does
+    const Transform2D *m = &state.current;
+    int x0 = (int)ceilf(x + m->e - 0.5f);
+    int y0 = (int)ceilf(y + m->f - 0.5f);
+    int x1 = (int)ceilf(x + m->e + width - 0.5f);
+    int y1 = (int)ceilf(y + m->f + height - 0.5f);
+
+    if (!ClipToScreen(&x0, &y0, &x1, &y1, bufWidth, bufHeight) || (color.a == 0)) return true;
+
+    uint16_t pixel = ColorTo565(color);
+    bool topDown = EspTopDownEnabled();
+
+    for (int row = y0; row < y1; row++) {
+        uint16_t *dst = buf + ((topDown? row : bufHeight - 1 - row) * bufWidth) + x0;
+        if (color.a == 255) EspPixelFill(dst, pixel, x1 - x0);
+        else EspPixelBlend(dst, pixel, color.a, x1 - x0);
+    }
+
+    ESP_RENDER_STATS(EspStatsFastDraw());
+    ESP_RENDER_STATS(EspStatsRect(x0, y0, x1, y1, color.a < 255));
+    if (EspDamageEnabled()) EspDamageAdd(x0, y0, x1 - x0, y1 - y0);
+    return true;
+#else
+    return false;
+#endif
+}
+
+// Copy an unscaled texture region with row blits, false if the general path must draw it
+// (texture without shadow, flipped or fractional source, fractional destination)
+static bool FastBlit(Texture2D texture, Rectangle source, float x, float y, Color tint)
+{
+#if SUPPORT_ESP_FAST_BLIT
+    if (!TranslationOnly() || (state.blendMode != BLEND_ALPHA)) return false;
+    if ((source.width <= 0.0f) || (source.height <= 0.0f)) return false;
+
+    const EspTextureShadow *tex = EspTextureFind(texture.id);
+    if (!tex || !tex->pixels) return false;
+
+    // Integer-aligned texels map one to one onto pixel centers
+    const Transform2D *m = &state.current;
+    float dx = x + m->e, dy = y + m->f;
+    if ((dx != floorf(dx)) || (dy != floorf(dy)) || (source.x != floorf(source.x)) || (source.y != floorf(source.y)) ||
+        (source.width != floorf(source.width)) || (source.height != floorf(source.height))) return false;
+
+    int sx = (int)source.x, sy = (int)source.y;
+    int width = (int)source.width, height = (int)source.height;
+    if ((sx < 0) || (sy < 0) || (sx + width > tex->width) || (sy + height > tex->height)) return false;
+
+    int bufWidth = 0, bufHeight = 0;
+    uint16_t *buf = ScreenBuffer(&bufWidth, &bufHeight);
+    if (!buf) return false;
+
+    int x0 = (int)dx, y0 = (int)dy;
+    int x1 = x0 + width, y1 = y0 + height;
+    if (!ClipToScreen(&x0, &y0, &x1, &y1, bufWidth, bufHeight) || (tint.a == 0)) return true;
+
+    sx += x0 - (int)dx;
+    sy += y0 - (int)dy;
+
+    bool tinted = (tint.r != 255) || (tint.g != 255) || (tint.b != 255) || (tint.a != 255);
+    bool topDown = EspTopDownEnabled();
+
+    for (int row = y0; row < y1; row++) {
+        uint16_t *dst = buf + ((topDown? row : bufHeight - 1 - row) * bufWidth) + x0;
+        int index = (sy + row - y0)*tex->width + sx;
+        const uint16_t *src = tex->pixels + index;
+        const uint8_t *alpha = tex->alpha? tex->alpha + index : NULL;
+
+        if (tinted || (tex->kind == ESP_TEXTURE_BLENDED)) EspPixelBlitBlend(dst, src, alpha, (uint32_t)ColorToInt(tint), x1 - x0);
+        else if (tex->kind == ESP_TEXTURE_KEYED) EspPixelBlitKeyed(dst, src, alpha, x1 - x0);
+        else EspPixelCopy(dst, src, x1 - x0);
+    }
+
+    ESP_RENDER_STATS(EspStatsFastDraw());
+    ESP_RENDER_STATS(EspStatsRect(x0, y0, x1, y1, tinted || (tex->kind != ESP_TEXTURE_OPAQUE)));
+    if (EspDamageEnabled()) EspDamageAdd(x0, y0, x1 - x0, y1 - y0);
+    return true;
+#else
+    return false;
+#endif
+}
+
+// Draw text from cached glyph masks, same layout as DrawTextEx() with pen positions rounded
+// to whole pixels, false if the general path must draw it
+static bool FastText(Font font, const char *text, Vector2 position, float fontSize, float spacing, Color tint)
+{
+#if SUPPORT_ESP_GLYPH_CACHE
+    if (!TranslationOnly() || (state.blendMode != BLEND_ALPHA) || !text) return false;
+
+    if (font.texture.id == 0) font = GetFontDefault();
+    // Masks come from the atlas alpha plane, kept for GRAY_ALPHA atlases
+    const EspTextureShadow *atlas = EspTextureFind(font.texture.id);
+    if (!atlas || (!atlas->alpha && (atlas->kind != ESP_TEXTURE_OPAQUE)) || (font.baseSize <= 0)) return false;
+
+    int bufWidth = 0, bufHeight = 0;
+    uint16_t *buf = ScreenBuffer(&bufWidth, &bufHeight);
+    if (!buf) return false;
+    if (tint.a == 0) return true;
+
+    const Transform2D *m = &state.current;
+    uint16_t pixel = ColorTo565(tint);
+    bool topDown = EspTopDownEnabled();
+    float scale = fontSize/(float)font.baseSize;
+    float offsetX = 0.0f, offsetY = 0.0f;
+    int minX = bufWidth, minY = bufHeight, maxX = 0, maxY = 0;
+
+    int length = TextLength(text);
+    for (int i = 0; i < length;) {
+        int byteCount = 0;
+        int codepoint = GetCodepointNext(&text[i], &byteCount);
+        int index = GetGlyphIndex(font, codepoint);
+        i += byteCount;
+
+        if (codepoint == '\n') {
+            offsetY += fontSize + (float)state.textLineSpacing;
+            offsetX = 0.0f;
+            continue;
+        }
+
+        if ((codepoint != ' ') && (codepoint != '\t')) {
+            Vector2 pen = { position.x + offsetX, position.y + offsetY };
+            const EspGlyph *glyph = EspGlyphFind(font, index, fontSize);
+
+            if (!glyph) {
+                DrawTextCodepoint(font, codepoint, pen, fontSize, tint);
+            } else {
+                int gx = (int)floorf(pen.x + m->e + 0.5f) + glyph->x;
+                int gy = (int)floorf(pen.y + m->f + 0.5f) + glyph->y;
+                int x0 = gx, y0 = gy, x1 = gx + glyph->width, y1 = gy + glyph->height;
+
+                if (ClipToScreen(&x0, &y0, &x1, &y1, bufWidth, bufHeight)) {
+                    for (int row = y0; row < y1; row++) {
+                        uint16_t *dst = buf + ((topDown? row : bufHeight - 1 - row) * bufWidth) + x0;
+                        EspPixelMask(dst, glyph->mask + (row - gy)*glyph->width + (x0 - gx), pixel, tint.a, x1 - x0);
+                    }
+                    ESP_RENDER_STATS(EspStatsRect(x0, y0, x1, y1, true));
+
+                    if (x0 < minX) minX = x0;
+                    if (y0 < minY) minY = y0;
+                    if (x1 > maxX) maxX = x1;
+                    if (y1 > maxY) maxY = y1;
+                }
+            }
+        }
+
+        if (font.glyphs[index].advanceX == 0) offsetX += (float)font.recs[index].width*scale + spacing;
+        else offsetX += (float)font.glyphs[index].advanceX*scale + spacing;
+    }
+
+    ESP_RENDER_STATS(EspStatsFastDraw());
+    if (EspDamageEnabled() && (maxX > minX) && (maxY > minY)) EspDamageAdd(minX, minY, maxX - minX, maxY - minY);
+    return true;
+#else
+    return false;
+#endif
+}
+
+// Clear the screen color buffer with span writes, rlsw only clears depth (nothing in the 2D profile)
+static bool FastClear(Color color)
+{
+#if SUPPORT_ESP_FAST_RECT || SUPPORT_ESP_2D_ONLY
+    int bufWidth = 0, bufHeight = 0;
+    uint16_t *buf = ScreenBuffer(&bufWidth, &bufHeight);
+    if (!buf) return false;
+
+    EspPixelFill(buf, ColorTo565(color), bufWidth * bufHeight);
+#if !SUPPORT_ESP_2D_ONLY
+    swClear(SW_DEPTH_BUFFER_BIT);
+#endif
+    return true;
+#else
+    return false;
+#endif
+}
+
+#if SUPPORT_ESP_FAST_RECT_BENCHMARK
+// Time the general and fast paths on the same rectangles, once at the first BeginDrawing()
+static void FastRectBenchmark(void)
+{
+    enum { BENCH_RECTS = 100, BENCH_WIDTH = 96, BENCH_HEIGHT = 64 };
+    Color colors[2] = { { 230, 41, 55, 255 }, { 0, 121, 241, 128 } };
+    int64_t elapsed[2][2] = { 0 };
+
+    for (int c = 0; c < 2; c++) {
+        for (int path = 0; path < 2; path++) {
+            int64_t start = esp_timer_get_time();
+            for (int i = 0; i < BENCH_RECTS; i++) {
+                int x = (i*37) % (GetScreenWidth() - BENCH_WIDTH);
+                int y = (i*23) % (GetScreenHeight() - BENCH_HEIGHT);
+                if (path == 0) __real_DrawRectangle(x, y, BENCH_WIDTH, BENCH_HEIGHT, colors[c]);
+                else FastRect((float)x, (float)y, (float)BENCH_WIDTH, (float)BENCH_HEIGHT, colors[c]);
+            }
+            elapsed[c][path] = esp_timer_get_time() - start;
+        }
+    }
+
+    TRACELOG(LOG_INFO, "RECT: %d rects %dx%d, opaque %lld us -> %lld us, blended %lld us -> %lld us",
+             BENCH_RECTS, BENCH_WIDTH, BENCH_HEIGHT, elapsed[0][0], elapsed[0][1], elapsed[1][0], elapsed[1][1]);
+}
+#endif
+
+//----------------------------------------------------------------------------------
+// Top-down orientation
+//----------------------------------------------------------------------------------
+
+// Load a screen projection with y growing along rlsw rows, so the color buffer is stored
+// in display order and needs no vertical flip at present time
+static void ApplyTopDownProjection(void)
+{
+    __real_rlMatrixMode(RL_PROJECTION);
+    __real_rlLoadIdentity();
+    rlOrtho(0, GetScreenWidth(), 0, GetScreenHeight(), 0.0, 1.0);
+    __real_rlMatrixMode(RL_MODELVIEW);
+
+    // The flip reverses triangle winding
+    rlSetCullFace(RL_CULL_FACE_FRONT);
+}
+
+//----------------------------------------------------------------------------------
+// rlgl: vertex level functions
+//----------------------------------------------------------------------------------
+
+void __wrap_rlBegin(int mode)
+{
+    bool recording = Recording();
+
+    ESP_RENDER_STATS(StatsBegin(mode));
+
+    if (EspDamageEnabled() || recording) {
+        bounds.minX = bounds.minY = INFINITY;
+        bounds.maxX = bounds.maxY = -INFINITY;
+        bounds.active = true;
+    }
+
+    if (recording) EspListAdd(ESP_LIST_BEGIN, mode, 0.0f, 0.0f, 0.0f, 0.0f);
+    else __real_rlBegin(mode);
+}
+
+void __wrap_rlEnd(void)
+{
+    if (!Recording()) __real_rlEnd();
+
+    if (bounds.active) BoundsCommit();
+}
+
+void __wrap_rlVertex2i(int x, int y)
+{
+    BoundsAdd((float)x, (float)y);
+    ESP_RENDER_STATS(StatsVertex((float)x, (float)y));
+
+    if (Recording()) EspListAdd(ESP_LIST_VERTEX2, 0, (float)x, (float)y, 0.0f, 0.0f);
+    else __real_rlVertex2i(x, y);
+}
+
+void __wrap_rlVertex2f(float x, float y)
+{
+    BoundsAdd(x, y);
+    ESP_RENDER_STATS(StatsVertex(x, y));
+
+    if (Recording()) EspListAdd(ESP_LIST_VERTEX2, 0, x, y, 0.0f, 0.0f);
+    else __real_rlVertex2f(x, y);
+}
+
+void __wrap_rlVertex3f(float x, float y, float z)
+{
+    BoundsAdd(x, y);
+    ESP_RENDER_STATS(StatsVertex(x, y));
+
+    if (Recording()) EspListAdd(ESP_LIST_VERTEX3, 0, x, y, z, 0.0f);
+    else __real_rlVertex3f(x, y, z);
+}
+
+void __wrap_rlTexCoord2f(float x, float y)
+{
+    if (Recording()) EspListAdd(ESP_LIST_TEXCOORD, 0, x, y, 0.0f, 0.0f);
+    else __real_rlTexCoord2f(x, y);
+}
+
+void __wrap_rlNormal3f(float x, float y, float z)
+{
+    if (Recording()) EspListAdd(ESP_LIST_NORMAL, 0, x, y, z, 0.0f);
+    else __real_rlNormal3f(x, y, z);
+}
+
+void __wrap_rlColor4ub(unsigned char r, unsigned char g, unsigned char b, unsigned char a)
+{
+    ESP_RENDER_STATS(EspStatsColor(a));
+
+    if (Recording()) EspListAdd(ESP_LIST_COLOR, 0, r, g, b, a);
+    else __real_rlColor4ub(r, g, b, a);
+}
+
+void __wrap_rlColor4f(float x, float y, float z, float w)
+{
+    ESP_RENDER_STATS(EspStatsColor((unsigned char)(w*255.0f)));
+
+    if (Recording()) EspListAdd(ESP_LIST_COLOR, 0, x*255.0f, y*255.0f, z*255.0f, w*255.0f);
+    else __real_rlColor4f(x, y, z, w);
+}
+
+void __wrap_rlColor3f(float x, float y, float z)
+{
+    ESP_RENDER_STATS(EspStatsColor(255));
+
+    if (Recording()) EspListAdd(ESP_LIST_COLOR, 0, x*255.0f, y*255.0f, z*255.0f, 255.0f);
+    else __real_rlColor3f(x, y, z);
+}
+
+void __wrap_rlSetTexture(unsigned int id)
+{
+    if (id != 0) EspTextureUse(id);
+    ESP_RENDER_STATS(EspStatsTexture(id));
+
+    if (Recording()) EspListAdd(ESP_LIST_TEXTURE, 0, (float)id, 0.0f, 0.0f, 0.0f);
+    else __real_rlSetTexture(id);
+}
+
+//----------------------------------------------------------------------------------
+// rlgl: matrix operations (mirrored for the modelview matrix only)
+//----------------------------------------------------------------------------------
+
+void __wrap_rlMatrixMode(int mode)
+{
+    state.modelview = (mode == RL_MODELVIEW);
+
+    if (Recording()) EspListAdd(ESP_LIST_MATRIX_MODE, mode, 0.0f, 0.0f, 0.0f, 0.0f);
+    else __real_rlMatrixMode(mode);
+}
+
+void __wrap_rlPushMatrix(void)
+{
+    if (state.modelview && (state.depth < RL_MAX_MATRIX_STACK_SIZE)) state.stack[state.depth++] = state.current;
+
+    if (Recording()) EspListAdd(ESP_LIST_PUSH, 0, 0.0f, 0.0f, 0.0f, 0.0f);
+    else __real_rlPushMatrix();
+}
+
+void __wrap_rlPopMatrix(void)
+{
+    if (state.modelview && (state.depth > 0)) state.current = state.stack[--state.depth];
+
+    if (Recording()) EspListAdd(ESP_LIST_POP, 0, 0.0f, 0.0f, 0.0f, 0.0f);
+    else __real_rlPopMatrix();
+}
+
+void __wrap_rlLoadIdentity(void)
+{
+    if (state.modelview) state.current = IDENTITY;
+    else state.projectionChanged = true;
+
+    if (Recording()) EspListAdd(ESP_LIST_IDENTITY, 0, 0.0f, 0.0f, 0.0f, 0.0f);
+    else __real_rlLoadIdentity();
+}
+
+void __wrap_rlTranslatef(float x, float y, float z)
+{
+    if (state.modelview) {
+        Transform2D t = { 1.0f, 0.0f, 0.0f, 1.0f, x, y, true };
+        TransformMultiply(&state.current, &t);
+    }
+    else state.projectionChanged = true;
+
+    if (Recording()) EspListAdd(ESP_LIST_TRANSLATE, 0, x, y, z, 0.0f);
+    else __real_rlTranslatef(x, y, z);
+}
+
+void __wrap_rlRotatef(float angle, float x, float y, float z)
+{
+    if (state.modelview) {
+        if ((x == 0.0f) && (y == 0.0f) && (z != 0.0f)) {
+            float rad = angle*(PI/180.0f)*((z > 0.0f)? 1.0f : -1.0f);
+            float s = sinf(rad);
+            float c = cosf(rad);
+            Transform2D t = { c, s, -s, c, 0.0f, 0.0f, true };
+            TransformMultiply(&state.current, &t);
+        }
+        else state.current.affine = false;
+    }
+    else state.projectionChanged = true;
+
+    if (Recording()) EspListAdd(ESP_LIST_ROTATE, 0, angle, x, y, z);
+    else __real_rlRotatef(angle, x, y, z);
+}
+
+void __wrap_rlScalef(float x, float y, float z)
+{
+    if (state.modelview) {
+        Transform2D t = { x, 0.0f, 0.0f, y, 0.0f, 0.0f, true };
+        TransformMultiply(&state.current, &t);
+    }
+    else state.projectionChanged = true;
+
+    if (Recording()) EspListAdd(ESP_LIST_SCALE, 0, x, y, z, 0.0f);
+    else __real_rlScalef(x, y, z);
+}
+
+void __wrap_rlMultMatrixf(const float *matf)
+{
+    if (state.modelview) {
+        Transform2D t = TransformFromMatrix(matf);
+        TransformMultiply(&state.current, &t);
+    }
+    else state.projectionChanged = true;
+
+    if (Recording()) EspListAddMatrix(matf);
+    else __real_rlMultMatrixf(matf);
+}
+
+//----------------------------------------------------------------------------------
+// rcore: drawing mode entry points called by the application
+//----------------------------------------------------------------------------------
+
+void __wrap_BeginDrawing(void)
+{
+    // Frame profiler: both phases end in SwapScreenBuffer() (rcore_esp_idf.c)
+    ESP_PROFILE_BEGIN(RAYLIB_ESP_PHASE_FRAME);
+    ESP_PROFILE_BEGIN(RAYLIB_ESP_PHASE_DRAW);
+
+    __real_BeginDrawing();
+
+    if (EspTopDownEnabled() && !state.textureMode) ApplyTopDownProjection();
+
+    // BeginDrawing() resets the modelview matrix (screen scale is identity on ESP-IDF)
+    state.current = IDENTITY;
+    state.depth = 0;
+    state.modelview = true;
+    state.projectionChanged = false;
+
+    state.mode3D = false;
+    state.blendMode = BLEND_ALPHA;
+
+    if (!state.textureMode) EspTextureFrame();
+    if (!state.textureMode) ESP_RENDER_STATS(EspStatsFrameBegin());
+
+#if SUPPORT_ESP_FAST_RECT_BENCHMARK
+    static bool benchmarked = false;
+    if (!benchmarked && (EspBandLines() == 0) && !state.textureMode) {
+        benchmarked = true;
+        FastRectBenchmark();
+    }
+#endif
+
+    if ((EspBandLines() > 0) && !state.textureMode) EspListBegin();
+}
+
+void __wrap_ClearBackground(Color color)
+{
+    if (Recording()) EspListAdd(ESP_LIST_CLEAR, 0, color.r, color.g, color.b, color.a);
+    else if (!FastClear(color)) __real_ClearBackground(color);
+
+    if (EspDamageEnabled() && !state.textureMode) EspDamageAddFull();
+}
+
+void __wrap_BeginMode2D(Camera2D camera)
+{
+    // BeginMode2D() loads identity and multiplies by the camera matrix
+    Matrix mat = GetCameraMatrix2D(camera);
+    Transform2D t = { mat.m0, mat.m1, mat.m4, mat.m5, mat.m12, mat.m13, true };
+
+    if (Recording()) {
+        float matf[16] = {
+            mat.m0, mat.m1, mat.m2, mat.m3, mat.m4, mat.m5, mat.m6, mat.m7,
+            mat.m8, mat.m9, mat.m10, mat.m11, mat.m12, mat.m13, mat.m14, mat.m15
+        };
+        EspListAdd(ESP_LIST_IDENTITY, 0, 0.0f, 0.0f, 0.0f, 0.0f);
+        EspListAddMatrix(matf);
+    }
+    else __real_BeginMode2D(camera);
+
+    state.current = t;
+}
+
+void __wrap_EndMode2D(void)
+{
+    if (Recording()) EspListAdd(ESP_LIST_IDENTITY, 0, 0.0f, 0.0f, 0.0f, 0.0f);
+    else __real_EndMode2D();
+
+    state.current = IDENTITY;
+}
+
+void __wrap_BeginTextureMode(RenderTexture2D target)
+{
+    __real_BeginTextureMode(target);
+
+    // Render textures keep the regular orientation
+    if (EspTopDownEnabled()) rlSetCullFace(RL_CULL_FACE_BACK);
+
+    state.textureMode = true;
+    state.current = IDENTITY;
+}
+
+void __wrap_EndTextureMode(void)
+{
+    __real_EndTextureMode();
+
+    // EndTextureMode() restores the default screen projection
+    if (EspTopDownEnabled()) ApplyTopDownProjection();
+
+    state.textureMode = false;
+    state.current = IDENTITY;
+
+    // EndTextureMode() leaves an identity modelview, replay must do the same
+    if (Recording()) {
+        EspListAdd(ESP_LIST_MATRIX_MODE, RL_MODELVIEW, 0.0f, 0.0f, 0.0f, 0.0f);
+        EspListAdd(ESP_LIST_IDENTITY, 0, 0.0f, 0.0f, 0.0f, 0.0f);
+    }
+}
+
+void __wrap_BeginScissorMode(int x, int y, int width, int height)
+{
+    if (Recording()) EspListAdd(ESP_LIST_SCISSOR, 0, (float)x, (float)y, (float)width, (float)height);
+    else {
+        __real_BeginScissorMode(x, y, width, height);
+
+        // BeginScissorMode() converts to a bottom-left origin, rows are top-down already
+        if (EspTopDownEnabled() && !state.textureMode) rlScissor(x, y, width, height);
+    }
+
+    state.scissor = true;
+    state.scissorRect = (EspRect){ x, y, width, height };
+}
+
+void __wrap_EndScissorMode(void)
+{
+    if (Recording()) EspListAdd(ESP_LIST_SCISSOR_END, 0, 0.0f, 0.0f, 0.0f, 0.0f);
+    else __real_EndScissorMode();
+
+    state.scissor = false;
+}
+
+void __wrap_BeginBlendMode(int mode)
+{
+    if (Recording()) EspListAdd(ESP_LIST_BLEND, mode, 0.0f, 0.0f, 0.0f, 0.0f);
+    else __real_BeginBlendMode(mode);
+
+    state.blendMode = mode;
+}
+
+void __wrap_EndBlendMode(void)
+{
+    if (Recording()) EspListAdd(ESP_LIST_BLEND, BLEND_ALPHA, 0.0f, 0.0f, 0.0f, 0.0f);
+    else __real_EndBlendMode();
+
+    state.blendMode = BLEND_ALPHA;
+}
+
+// Record what BeginMode3D() does inside rcore.c (not interposed): push a camera projection for
+// the full screen, which replay crops to each band, and load the camera view
+static void RecordMode3D(Camera3D camera)
+{
+    float aspect = (float)GetScreenWidth()/(float)GetScreenHeight();
+    float n = (float)rlGetCullDistanceNear(), f = (float)rlGetCullDistanceFar();
+    float proj[16] = { 0 };
+
+    if (camera.projection == CAMERA_ORTHOGRAPHIC) {
+        float top = camera.fovy*0.5f, right = top*aspect;
+        proj[0] = 1.0f/right;
+        proj[5] = 1.0f/top;
+        proj[10] = -2.0f/(f - n);
+        proj[14] = -(f + n)/(f - n);
+        proj[15] = 1.0f;
+    }
+    else {
+        float top = n*tanf(camera.fovy*0.5f*DEG2RAD), right = top*aspect;
+        proj[0] = n/right;
+        proj[5] = n/top;
+        proj[10] = -(f + n)/(f - n);
+        proj[11] = -1.0f;
+        proj[14] = -2.0f*f*n/(f - n);
+    }
+
+    Matrix view = GetCameraMatrix(camera);
+    float viewf[16] = {
+        view.m0, view.m1, view.m2, view.m3, view.m4, view.m5, view.m6, view.m7,
+        view.m8, view.m9, view.m10, view.m11, view.m12, view.m13, view.m14, view.m15
+    };
+
+    EspListAdd(ESP_LIST_MATRIX_MODE, RL_PROJECTION, 0.0f, 0.0f, 0.0f, 0.0f);
+    EspListAdd(ESP_LIST_PUSH, 0, 0.0f, 0.0f, 0.0f, 0.0f);
+    EspListAddProjection(proj);
+    EspListAdd(ESP_LIST_MATRIX_MODE, RL_MODELVIEW, 0.0f, 0.0f, 0.0f, 0.0f);
+    EspListAdd(ESP_LIST_IDENTITY, 0, 0.0f, 0.0f, 0.0f, 0.0f);
+    EspListAddMatrix(viewf);
+    EspListAdd(ESP_LIST_DEPTH_TEST, SUPPORT_ESP_2D_ONLY? 0 : 1, 0.0f, 0.0f, 0.0f, 0.0f);
+}
+
+void __wrap_BeginMode3D(Camera3D camera)
+{
+    if (Recording()) RecordMode3D(camera);
+    else {
+        __real_BeginMode3D(camera);
+
+        // Flip the camera projection like the top-down screen projection (camera frustums are
+        // symmetric in y, so flipping eye space flips clip space). Winding stays reversed, the
+        // front cull face set by ApplyTopDownProjection() still applies
+        if (EspTopDownEnabled() && !state.textureMode) {
+            __real_rlMatrixMode(RL_PROJECTION);
+            __real_rlScalef(1.0f, -1.0f, 1.0f);
+            __real_rlMatrixMode(RL_MODELVIEW);
+        }
+    }
+
+#if SUPPORT_ESP_2D_ONLY
+    // Depth is never cleared in the 2D profile, draw in submission order instead
+    static bool warned = false;
+    if (!warned) {
+        TRACELOG(LOG_WARNING, "RLGL: 2D-only profile, BeginMode3D() draws without depth testing");
+        warned = true;
+    }
+    if (!Recording()) rlDisableDepthTest();
+#endif
+
+    // Perspective projection: primitives may cover any part of the screen
+    state.mode3D = true;
+    state.projectionChanged = true;
+    state.current = IDENTITY;
+}
+
+void __wrap_EndMode3D(void)
+{
+    // EndMode3D() pops the camera projection, loads identity and disables depth testing
+    if (Recording()) {
+        EspListAdd(ESP_LIST_MATRIX_MODE, RL_PROJECTION, 0.0f, 0.0f, 0.0f, 0.0f);
+        EspListAdd(ESP_LIST_POP, 0, 0.0f, 0.0f, 0.0f, 0.0f);
+        EspListAdd(ESP_LIST_MATRIX_MODE, RL_MODELVIEW, 0.0f, 0.0f, 0.0f, 0.0f);
+        EspListAdd(ESP_LIST_IDENTITY, 0, 0.0f, 0.0f, 0.0f, 0.0f);
+        EspListAdd(ESP_LIST_DEPTH_TEST, 0, 0.0f, 0.0f, 0.0f, 0.0f);
+    }
+    else __real_EndMode3D();
+
+    // EndMode3D() restores the default screen projection
+    if (EspTopDownEnabled() && !state.textureMode) ApplyTopDownProjection();
+
+    state.mode3D = false;
+    state.current = IDENTITY;
+}
+
+//----------------------------------------------------------------------------------
+// rshapes: rectangle entry points (fast path)
+//----------------------------------------------------------------------------------
+
+void __wrap_DrawRectangle(int posX, int posY, int width, int height, Color color)
+{
+    if (!FastRect((float)posX, (float)posY, (float)width, (float)height, color)) __real_DrawRectangle(posX, posY, width, height, color);
+}
+
+void __wrap_DrawRectangleV(Vector2 position, Vector2 size, Color color)
+{
+    if (!FastRect(position.x, position.y, size.x, size.y, color)) __real_DrawRectangleV(position, size, color);
+}
+
+void __wrap_DrawRectangleRec(Rectangle rec, Color color)
+{
+    if (!FastRect(rec.x, rec.y, rec.width, rec.height, color)) __real_DrawRectangleRec(rec, color);
+}
+
+//----------------------------------------------------------------------------------
+// rtextures: texture entry points (fast path)
+//----------------------------------------------------------------------------------
+
+void __wrap_DrawTexture(Texture2D texture, int posX, int posY, Color tint)
+{
+    Rectangle source = { 0.0f, 0.0f, (float)texture.width, (float)texture.height };
+    if (!FastBlit(texture, source, (float)posX, (float)posY, tint)) __real_DrawTexture(texture, posX, posY, tint);
+}
+
+void __wrap_DrawTextureV(Texture2D texture, Vector2 position, Color tint)
+{
+    Rectangle source = { 0.0f, 0.0f, (float)texture.width, (float)texture.height };
+    if (!FastBlit(texture, source, position.x, position.y, tint)) __real_DrawTextureV(texture, position, tint);
+}
+
+void __wrap_DrawTextureEx(Texture2D texture, Vector2 position, float rotation, float scale, Color tint)
+{
+    Rectangle source = { 0.0f, 0.0f, (float)texture.width, (float)texture.height };
+    if ((rotation != 0.0f) || (scale != 1.0f) || !FastBlit(texture, source, position.x, position.y, tint)) {
+        __real_DrawTextureEx(texture, position, rotation, scale, tint);
+    }
+}
+
+void __wrap_DrawTextureRec(Texture2D texture, Rectangle source, Vector2 position, Color tint)
+{
+    if (!FastBlit(texture, source, position.x, position.y, tint)) __real_DrawTextureRec(texture, source, position, tint);
+}
+
+//----------------------------------------------------------------------------------
+// rtext: text entry points (glyph cache fast path)
+//----------------------------------------------------------------------------------
+
+void __wrap_DrawText(const char *text, int posX, int posY, int fontSize, Color color)
+{
+    // Same default font sizing as DrawText()
+    Font font = GetFontDefault();
+    int size = (fontSize < 10)? 10 : fontSize;
+    Vector2 position = { (float)posX, (float)posY };
+
+    if ((font.texture.id == 0) || !FastText(font, text, position, (float)size, (float)(size/10), color)) {
+        __real_DrawText(text, posX, posY, fontSize, color);
+    }
+}
+
+void __wrap_DrawTextEx(Font font, const char *text, Vector2 position, float fontSize, float spacing, Color tint)
+{
+    if (!FastText(font, text, position, fontSize, spacing, tint)) __real_DrawTextEx(font, text, position, fontSize, spacing, tint);
+}
+
+void __wrap_SetTextLineSpacing(int spacing)
+{
+    __real_SetTextLineSpacing(spacing);
+    state.textLineSpacing = spacing;
+}
+
+//----------------------------------------------------------------------------------
+// Sprite batches
+//----------------------------------------------------------------------------------
+
+// Screen rectangle sprites can be culled against, false when the transform or target makes
+// screen bounds unknown
+static bool SpriteCullRect(EspRect *rect)
+{
+    if (state.textureMode || state.mode3D || state.projectionChanged || !TranslationOnly()) return false;
+
+    *rect = state.scissor? state.scissorRect : (EspRect){ 0, 0, GetScreenWidth(), GetScreenHeight() };
+    return true;
+}
+
+void raylib_esp_draw_sprite_batch(Texture2D texture, const raylib_esp_sprite_batch_t *batch)
+{
+    if (!batch || (batch->count <= 0) || !batch->x || !batch->y || (texture.id == 0)) return;
+
+    const Transform2D *m = &state.current;
+    float scale = (batch->scale > 0.0f)? batch->scale : 1.0f;
+    Rectangle whole = { 0.0f, 0.0f, (float)texture.width, (float)texture.height };
+    float invWidth = 1.0f/(float)texture.width, invHeight = 1.0f/(float)texture.height;
+
+    EspRect cull = { 0 };
+    bool culling = SpriteCullRect(&cull);
+    const EspTextureShadow *shadow = EspTextureFind(texture.id);
+    bool blit = (scale == 1.0f) && !batch->rotation && shadow && shadow->pixels;
+    bool open = false, textured = false;
+
+    for (int i = 0; i < batch->count; i++) {
+        Rectangle src = batch->source? batch->source[i] : whole;
+        Color tint = batch->tint? batch->tint[i] : WHITE;
+        float angle = batch->rotation? batch->rotation[i] : 0.0f;
+        float x = batch->x[i], y = batch->y[i];
+        float width = fabsf(src.width)*scale, height = fabsf(src.height)*scale;
+
+        if (tint.a == 0) continue;
+
+        if (culling) {
+            // Rotated sprites stay within the circle around their center
+            float cx = x + width*0.5f + m->e, cy = y + height*0.5f + m->f;
+            float rx = width*0.5f, ry = height*0.5f;
+            if (angle != 0.0f) rx = ry = sqrtf(rx*rx + ry*ry);
+
+            if ((cx + rx <= (float)cull.x) || (cx - rx >= (float)(cull.x + cull.width)) ||
+                (cy + ry <= (float)cull.y) || (cy - ry >= (float)(cull.y + cull.height))) continue;
+        }
+
+        if (blit) {
+            // Blits write the color buffer right away, finish the quads drawn so far first
+            if (open) {
+                rlEnd();
+                open = false;
+            }
+            if (FastBlit(texture, src, x, y, tint)) continue;
+        }
+
+        if (!open) {
+            if (!textured) rlSetTexture(texture.id);
+            textured = true;
+            rlBegin(RL_QUADS);
+            rlNormal3f(0.0f, 0.0f, 1.0f);
+            open = true;
+        }
+
+        // Texture coordinates, negative source sizes flip as in DrawTexturePro()
+        float u0 = src.x*invWidth, u1 = (src.x + fabsf(src.width))*invWidth;
+        float v0 = src.y*invHeight, v1 = (src.y + fabsf(src.height))*invHeight;
+        if (src.width < 0.0f) { float t = u0; u0 = u1; u1 = t; }
+        if (src.height < 0.0f) { float t = v0; v0 = v1; v1 = t; }
+
+        // Corners relative to the sprite center: top-left, bottom-left, bottom-right, top-right
+        float cx = x + width*0.5f, cy = y + height*0.5f;
+        float hx = width*0.5f, hy = height*0.5f;
+        float px[4] = { -hx, -hx, hx, hx };
+        float py[4] = { -hy, hy, hy, -hy };
+
+        if (angle != 0.0f) {
+            float s = sinf(angle*DEG2RAD), c = cosf(angle*DEG2RAD);
+            for (int k = 0; k < 4; k++) {
+                float rx = px[k]*c - py[k]*s;
+                py[k] = px[k]*s + py[k]*c;
+                px[k] = rx;
+            }
+        }
+
+        float us[4] = { u0, u0, u1, u1 };
+        float vs[4] = { v0, v1, v1, v0 };
+
+        rlColor4ub(tint.r, tint.g, tint.b, tint.a);
+        for (int k = 0; k < 4; k++) {
+            rlTexCoord2f(us[k], vs[k]);
+            rlVertex2f(cx + px[k], cy + py[k]);
+        }
+    }
+
+    if (open) rlEnd();
+    if (textured) rlSetTexture(0);
+}
@@ -0,0 +1,399 @@
+/**********************************************************************************************
+*
+*   rlist_esp_idf - Display list recorder for ESP-IDF
+*
+*   Records the screen draw calls of a frame (rlgl vertex, state and matrix calls reaching
+*   the interposition layer) so the frame can be rasterized later, any number of times,
+*   into a color buffer covering only part of the screen (band render mode)
+*
+*   Each primitive is binned by its screen bounds and knows where it ends, so replays of a
+*   band or tile outside those bounds jump straight past it
+*
+*   Replays can target a slice of a taller color buffer, so one slice is rasterized while
+*   another is still being presented by the present task (pipelined band present)
+*
+**********************************************************************************************/
+
+#include "config.h"
+#include "raylib.h"
+#include "rlgl.h"
+#include "esp_idf_internal.h"
+
+#include "esp_log.h"
+#include "esp_heap_caps.h"
+
+//----------------------------------------------------------------------------------
+// Real implementations (resolved by the linker, see rlgl_esp_idf.c)
+//----------------------------------------------------------------------------------
+void __real_rlBegin(int mode);
+void __real_rlEnd(void);
+void __real_rlVertex2f(float x, float y);
+void __real_rlVertex3f(float x, float y, float z);
+void __real_rlTexCoord2f(float x, float y);
+void __real_rlNormal3f(float x, float y, float z);
+void __real_rlColor4ub(unsigned char r, unsigned char g, unsigned char b, unsigned char a);
+void __real_rlSetTexture(unsigned int id);
+void __real_rlMatrixMode(int mode);
+void __real_rlPushMatrix(void);
+void __real_rlPopMatrix(void);
+void __real_rlLoadIdentity(void);
+void __real_rlTranslatef(float x, float y, float z);
+void __real_rlRotatef(float angle, float x, float y, float z);
+void __real_rlScalef(float x, float y, float z);
+void __real_rlMultMatrixf(const float *matf);
+void __real_ClearBackground(Color color);
+
+extern void *swGetColorBuffer(int *width, int *height);
+extern void swClear(uint32_t bitmask);
+
+#define SW_DEPTH_BUFFER_BIT 0x00000100  // GL_DEPTH_BUFFER_BIT, rlsw uses the GL values
+
+// Bin coordinates are int16_t: bounds are cut to this range (far beyond any screen) so
+// widths and heights fit as well
+#define LIST_BIN_LIMIT 16383
+
+//----------------------------------------------------------------------------------
+// Types and Structures
+//----------------------------------------------------------------------------------
+typedef struct {
+    uint8_t type;               // EspListOpType
+    int16_t arg;                // Primitive, matrix or blend mode
+    union {
+        float v[4];
+        struct {
+            int16_t x, y, width, height;    // ESP_LIST_BEGIN: screen bounds, within +-LIST_BIN_LIMIT
+            int32_t end;                    // ESP_LIST_BEGIN: index of the matching ESP_LIST_END
+            int32_t color;                  // ESP_LIST_BEGIN: index of the last color op inside, -1 if none
+        } bin;
+    };
+} ListOp;
+
+typedef struct {
+    ListOp *ops;                // Grows in PSRAM, reused across frames
+    int count;
+    int capacity;
+    int primitive;              // Index of the open ESP_LIST_BEGIN, -1 outside rlBegin()/rlEnd()
+    int color;                  // Last color op of the open primitive, -1 if none
+    bool recording;
+    bool overflow;              // Out of memory, frame is incomplete
+} ListData;
+
+//----------------------------------------------------------------------------------
+// Global Variables Definition
+//----------------------------------------------------------------------------------
+static ListData list = { .primitive = -1, .color = -1 };
+
+//----------------------------------------------------------------------------------
+// Module Internal Functions
+//----------------------------------------------------------------------------------
+
+static bool ListReserve(int count)
+{
+    if (list.count + count <= list.capacity) return true;
+
+    int capacity = (list.capacity > 0)? list.capacity*2 : ESP_LIST_INITIAL_OPS;
+    while (capacity < list.count + count) capacity *= 2;
+
+    ListOp *ops = heap_caps_realloc(list.ops, capacity*sizeof(ListOp), MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+    if (!ops) ops = heap_caps_realloc(list.ops, capacity*sizeof(ListOp), MALLOC_CAP_DEFAULT);
+    if (!ops) {
+        if (!list.overflow) ESP_LOGE("RAYLIB", "Display list out of memory (%d ops)", list.count);
+        list.overflow = true;
+        return false;
+    }
+
+    list.ops = ops;
+    list.capacity = capacity;
+    return true;
+}
+
+static bool RectsOverlap(EspRect a, EspRect b)
+{
+    return (a.x < b.x + b.width) && (b.x < a.x + a.width) &&
+           (a.y < b.y + b.height) && (b.y < a.y + a.height);
+}
+
+static int BinClamp(int v)
+{
+    return (v < -LIST_BIN_LIMIT)? -LIST_BIN_LIMIT : (v > LIST_BIN_LIMIT)? LIST_BIN_LIMIT : v;
+}
+
+static void ListAddMatrixOp(EspListOpType type, const float *matf)
+{
+    if (!ListReserve(5)) return;
+
+    EspListAdd(type, 0, 0.0f, 0.0f, 0.0f, 0.0f);
+    for (int k = 0; k < 4; k++) {
+        EspListAdd(ESP_LIST_MATRIX_DATA, 0, matf[k*4 + 0], matf[k*4 + 1], matf[k*4 + 2], matf[k*4 + 3]);
+    }
+}
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition
+//----------------------------------------------------------------------------------
+
+bool EspListRecording(void)
+{
+    return list.recording;
+}
+
+// Start recording a frame, the previous one is discarded
+void EspListBegin(void)
+{
+    list.count = 0;
+    list.primitive = -1;
+    list.color = -1;
+    list.overflow = false;
+    list.recording = true;
+}
+
+void EspListEnd(void)
+{
+    list.recording = false;
+}
+
+void EspListAdd(EspListOpType type, int arg, float a, float b, float c, float d)
+{
+    if (!ListReserve(1)) return;
+
+    if (type == ESP_LIST_BEGIN) {
+        list.primitive = list.count;
+        list.color = -1;
+    }
+    else if ((type == ESP_LIST_COLOR) && (list.primitive >= 0)) list.color = list.count;
+
+    list.ops[list.count++] = (ListOp){ (uint8_t)type, (int16_t)arg, { .v = { a, b, c, d } } };
+}
+
+// Column-major 4x4 matrix multiply, stored in the following four ops
+void EspListAddMatrix(const float *matf)
+{
+    ListAddMatrixOp(ESP_LIST_MULT, matf);
+}
+
+// Column-major projection matrix for the full screen, loaded cropped to each replayed area
+void EspListAddProjection(const float *matf)
+{
+    ListAddMatrixOp(ESP_LIST_PROJECTION, matf);
+}
+
+// Close the open primitive with its screen bounds, primitives covering nothing are dropped
+// (keeping their last color, which outlives rlEnd())
+void EspListEndPrimitive(bool visible, EspRect bounds)
+{
+    if (list.primitive < 0) return;
+
+    if (visible) {
+        EspListAdd(ESP_LIST_END, 0, 0.0f, 0.0f, 0.0f, 0.0f);
+
+        if (!list.overflow) {
+            int x0 = BinClamp(bounds.x), y0 = BinClamp(bounds.y);
+            int x1 = BinClamp(bounds.x + bounds.width), y1 = BinClamp(bounds.y + bounds.height);
+
+            ListOp *begin = &list.ops[list.primitive];
+            begin->bin.x = (int16_t)x0;
+            begin->bin.y = (int16_t)y0;
+            begin->bin.width = (int16_t)(x1 - x0);
+            begin->bin.height = (int16_t)(y1 - y0);
+            begin->bin.end = list.count - 1;
+            begin->bin.color = list.color;
+        }
+    }
+    else {
+        ListOp color = (list.color >= 0)? list.ops[list.color] : (ListOp){ 0 };
+        list.count = list.primitive;
+        if (color.type == ESP_LIST_COLOR) list.ops[list.count++] = color;
+    }
+
+    list.primitive = -1;
+    list.color = -1;
+}
+
+// Restrict drawing to the screen rect r (top-left origin) within the slice, in buffer rows
+// (bottom-left origin) starting at bufferRow
+static void ReplayScissor(EspRect clip, int bufferRow, EspRect r)
+{
+    int x0 = (r.x > clip.x)? r.x : clip.x;
+    int y0 = (r.y > clip.y)? r.y : clip.y;
+    int x1 = (r.x + r.width < clip.x + clip.width)? r.x + r.width : clip.x + clip.width;
+    int y1 = (r.y + r.height < clip.y + clip.height)? r.y + r.height : clip.y + clip.height;
+    if (x1 < x0) x1 = x0;
+    if (y1 < y0) y1 = y0;
+
+    rlEnableScissorTest();
+    rlScissor(x0 - clip.x, bufferRow + (clip.y + clip.height) - y1, x1 - x0, y1 - y0);
+}
+
+#if SUPPORT_ESP_2D_ONLY
+// Fill the slice rows of the color buffer, the depth buffer is left alone
+static void ReplayClearRows(EspRect clip, int bufferRow, const float *color)
+{
+    int sw_width = 0, sw_height = 0;
+    uint16_t *buf = (uint16_t *)swGetColorBuffer(&sw_width, &sw_height);
+    uint16_t pixel = (uint16_t)((((int)color[0] >> 3) << 11) | (((int)color[1] >> 2) << 5) | ((int)color[2] >> 3));
+
+    if (buf) EspPixelFill(buf + (bufferRow * sw_width), pixel, sw_width * clip.height);
+}
+#endif
+
+// rlsw clears the whole color buffer, a slice is cleared with an unblended quad instead
+static void ReplayClearSlice(EspRect clip, const float *color, int matrixMode, unsigned int texture)
+{
+    __real_rlSetTexture(0);
+    __real_rlMatrixMode(RL_MODELVIEW);
+    __real_rlPushMatrix();
+    __real_rlLoadIdentity();
+    rlDisableColorBlend();
+
+    __real_rlBegin(RL_QUADS);
+    __real_rlColor4ub((unsigned char)color[0], (unsigned char)color[1], (unsigned char)color[2], 255);
+    __real_rlVertex2f((float)clip.x, (float)clip.y);
+    __real_rlVertex2f((float)clip.x, (float)(clip.y + clip.height));
+    __real_rlVertex2f((float)(clip.x + clip.width), (float)(clip.y + clip.height));
+    __real_rlVertex2f((float)(clip.x + clip.width), (float)clip.y);
+    __real_rlEnd();
+
+    rlEnableColorBlend();
+    __real_rlPopMatrix();
+    __real_rlMatrixMode(matrixMode);
+    __real_rlSetTexture(texture);
+}
+
+static void ReplayMatrix(int index, float *m)
+{
+    for (int k = 0; k < 4; k++) {
+        const float *data = list.ops[index + 1 + k].v;
+        m[k*4 + 0] = data[0]; m[k*4 + 1] = data[1]; m[k*4 + 2] = data[2]; m[k*4 + 3] = data[3];
+    }
+}
+
+// Load a full-screen projection cropped to clip: NDC of the clip area scaled back to [-1, 1]
+static void ReplayProjection(EspRect clip, const float *m)
+{
+    float sx = (float)GetScreenWidth()/(float)clip.width;
+    float sy = (float)GetScreenHeight()/(float)clip.height;
+    float crop[16] = {
+        sx, 0.0f, 0.0f, 0.0f,
+        0.0f, sy, 0.0f, 0.0f,
+        0.0f, 0.0f, 1.0f, 0.0f,
+        sx - 1.0f - 2.0f*clip.x/clip.width, 1.0f - sy + 2.0f*clip.y/clip.height, 0.0f, 1.0f
+    };
+
+    __real_rlLoadIdentity();
+    __real_rlMultMatrixf(crop);
+    __real_rlMultMatrixf(m);
+}
+
+// Rasterize the recorded frame into the current color buffer rows [bufferRow, bufferRow + clip.height),
+// which cover the screen area clip, primitives outside clip are skipped
+void EspListReplay(EspRect clip, int bufferRow)
+{
+    if (list.overflow) return;
+
+    int sw_width = 0, sw_height = 0;
+    swGetColorBuffer(&sw_width, &sw_height);
+    bool slice = (bufferRow > 0) || (clip.height < sw_height);
+
+    // Map clip onto its buffer rows, default 2D state
+    rlViewport(0, bufferRow, clip.width, clip.height);
+    __real_rlMatrixMode(RL_PROJECTION);
+    __real_rlLoadIdentity();
+    rlOrtho(clip.x, clip.x + clip.width, clip.y + clip.height, clip.y, 0.0, 1.0);
+    __real_rlMatrixMode(RL_MODELVIEW);
+    __real_rlLoadIdentity();
+    if (slice) ReplayScissor(clip, bufferRow, clip);
+    else rlDisableScissorTest();
+    rlSetBlendMode(BLEND_ALPHA);
+    rlDisableDepthTest();
+    __real_rlSetTexture(0);
+
+    int matrixMode = RL_MODELVIEW;
+    unsigned int texture = 0;
+    bool depthCleared = false;
+
+    for (int i = 0; i < list.count; i++) {
+        const ListOp *op = &list.ops[i];
+        const float *v = op->v;
+
+        switch (op->type) {
+            case ESP_LIST_BEGIN: {
+                EspRect bounds = { op->bin.x, op->bin.y, op->bin.width, op->bin.height };
+                if (RectsOverlap(bounds, clip)) __real_rlBegin(op->arg);
+                else if (op->bin.end > i) {
+                    // Outside this band/tile, vertices and end skipped: its last color outlives rlEnd()
+                    if (op->bin.color >= 0) {
+                        const float *c = list.ops[op->bin.color].v;
+                        __real_rlColor4ub((unsigned char)c[0], (unsigned char)c[1], (unsigned char)c[2], (unsigned char)c[3]);
+                    }
+                    i = op->bin.end;
+                }
+                else i = list.count;                        // Primitive never closed (end of frame)
+            } break;
+            case ESP_LIST_END: __real_rlEnd(); break;
+            case ESP_LIST_VERTEX2: __real_rlVertex2f(v[0], v[1]); break;
+            case ESP_LIST_VERTEX3: __real_rlVertex3f(v[0], v[1], v[2]); break;
+            case ESP_LIST_TEXCOORD: __real_rlTexCoord2f(v[0], v[1]); break;
+            case ESP_LIST_NORMAL: __real_rlNormal3f(v[0], v[1], v[2]); break;
+            case ESP_LIST_COLOR: __real_rlColor4ub((unsigned char)v[0], (unsigned char)v[1], (unsigned char)v[2], (unsigned char)v[3]); break;
+            case ESP_LIST_TEXTURE: texture = (unsigned int)v[0]; __real_rlSetTexture(texture); break;
+            case ESP_LIST_MATRIX_MODE: matrixMode = op->arg; __real_rlMatrixMode(matrixMode); break;
+            case ESP_LIST_PUSH: __real_rlPushMatrix(); break;
+            case ESP_LIST_POP: __real_rlPopMatrix(); break;
+            case ESP_LIST_IDENTITY: __real_rlLoadIdentity(); break;
+            case ESP_LIST_TRANSLATE: __real_rlTranslatef(v[0], v[1], v[2]); break;
+            case ESP_LIST_ROTATE: __real_rlRotatef(v[0], v[1], v[2], v[3]); break;
+            case ESP_LIST_SCALE: __real_rlScalef(v[0], v[1], v[2]); break;
+            case ESP_LIST_MULT: {
+                // Column-major matrix in the following ESP_LIST_MATRIX_DATA ops
+                float m[16];
+                ReplayMatrix(i, m);
+                __real_rlMultMatrixf(m);
+                i += 4;
+            } break;
+            case ESP_LIST_PROJECTION: {
+                float m[16];
+                ReplayMatrix(i, m);
+                ReplayProjection(clip, m);
+                i += 4;
+            } break;
+            case ESP_LIST_CLEAR: {
+#if SUPPORT_ESP_2D_ONLY
+                ReplayClearRows(clip, bufferRow, v);
+#else
+                if (slice) ReplayClearSlice(clip, v, matrixMode, texture);
+                else __real_ClearBackground((Color){ (unsigned char)v[0], (unsigned char)v[1], (unsigned char)v[2], (unsigned char)v[3] });
+#endif
+            } break;
+            case ESP_LIST_SCISSOR: {
+                // Screen rect (top-left origin) to buffer rows (bottom-left origin)
+                if (slice) ReplayScissor(clip, bufferRow, (EspRect){ (int)v[0], (int)v[1], (int)v[2], (int)v[3] });
+                else {
+                    rlEnableScissorTest();
+                    rlScissor((int)v[0] - clip.x, (clip.y + clip.height) - ((int)v[1] + (int)v[3]), (int)v[2], (int)v[3]);
+                }
+            } break;
+            case ESP_LIST_SCISSOR_END: {
+                if (slice) ReplayScissor(clip, bufferRow, clip);
+                else rlDisableScissorTest();
+            } break;
+            case ESP_LIST_BLEND: rlSetBlendMode(op->arg); break;
+            case ESP_LIST_DEPTH_TEST: {
+                // The frame clear did not reach depth in slices, 2D draws never test it: clear
+                // once per replay (other slots only hold finished color)
+                if (op->arg && !depthCleared) {
+                    swClear(SW_DEPTH_BUFFER_BIT);
+                    depthCleared = true;
+                }
+                if (op->arg) rlEnableDepthTest();
+                else rlDisableDepthTest();
+            } break;
+            default: break;
+        }
+    }
+}
+
+void EspListClose(void)
+{
+    heap_caps_free(list.ops);
+    list = (ListData){ .primitive = -1, .color = -1 };
+}
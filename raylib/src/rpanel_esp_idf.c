@@ -0,0 +1,453 @@
+/**********************************************************************************************
+*
+*   rpanel_esp_idf - esp_lcd panel present stage for ESP-IDF
+*
+*   Sends screen regions straight to an esp_lcd panel: each region is read from the rlsw color
+*   buffer (or a present buffer) once, flipped and byte-swapped on the fly into a ring of
+*   DMA-capable internal bounce buffers sized to the panel max_transfer_sz, and drawn chunk by chunk
+*
+*   Bounce buffers are reused once the panel IO reports on_color_trans_done, so chunk k+1 is
+*   prepared while chunk k is still on the bus; the ring holds up to trans_queue_depth buffers
+*
+*   RGB panels can instead take regions straight into their own PSRAM frame buffers: the
+*   back buffer is filled, handed to draw_bitmap() (which only switches buffers, no copy)
+*   and becomes the scanout buffer on the next vsync
+*
+*   RGB panels created without frame buffers (no_fb, bounce buffer mode) can also scan out
+*   of the rlsw color buffer itself: the panel on_bounce_empty callback flips (and swaps)
+*   each bounce buffer worth of lines from the last presented frame, racing the beam
+*
+*   Panel callbacks run in the LCD interrupt and are placed in IRAM, so they keep running with
+*   CONFIG_LCD_RGB_ISR_IRAM_SAFE (or the panel IO ISR_IRAM_SAFE option) while flash is written
+*
+**********************************************************************************************/
+
+#include "config.h"
+#include "raylib.h"
+#include "rlgl.h"
+#include "raylib_esp.h"
+#include "esp_idf_internal.h"
+
+#include "sdkconfig.h"
+#include "esp_attr.h"
+#include "esp_log.h"
+#include "esp_heap_caps.h"
+#include "esp_timer.h"
+#include "esp_lcd_panel_io.h"
+#include "esp_lcd_panel_ops.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "soc/soc_caps.h"
+#include <string.h>
+
+#if SUPPORT_ESP_RGB_PANEL && SOC_LCD_RGB_SUPPORTED
+    #include "esp_lcd_panel_rgb.h"
+    #define PANEL_RGB_FRAME_BUFFERS     1
+#else
+    #define PANEL_RGB_FRAME_BUFFERS     0
+#endif
+
+//----------------------------------------------------------------------------------
+// Types and Structures
+//----------------------------------------------------------------------------------
+typedef struct {
+    esp_lcd_panel_handle_t panel;
+    esp_lcd_panel_io_handle_t io;       // NULL for panels that copy synchronously (e.g. RGB)
+    raylib_esp_panel_config_t config;
+    uint16_t *bounce[ESP_PANEL_MAX_BOUNCE_BUFFERS];
+    int bounceCount;                    // Bounce buffers in the ring
+    int bouncePixels;                   // Capacity of each bounce buffer (whole screen lines)
+    int next;                           // Next bounce buffer to fill
+    SemaphoreHandle_t free;             // Counts bounce buffers not owned by the DMA
+#if PANEL_RGB_FRAME_BUFFERS
+    uint16_t *frameBuffers[ESP_PANEL_MAX_RGB_FRAME_BUFFERS];
+    int frameBufferCount;               // 0 when presenting through bounce buffers
+    int back;                           // Frame buffer being filled
+    bool swapPending;                   // Back buffer is scanned out until the next vsync
+    SemaphoreHandle_t vsync;            // Given on vsync, or on bounce frame finish when scanning out
+
+    // Bounce buffer scanout, source read from the bounce callback (ISR)
+    bool scanout;
+    const uint16_t *volatile scanFirst; // Top-left pixel of the presented frame, NULL until the first frame
+    volatile int scanRowStep;
+    int64_t scanLastFill;               // Previous callback entry (us), 0 at frame start
+    int32_t scanMinSlack;               // Smallest time left before a bounce deadline this frame (us)
+    volatile int32_t scanFrameMinSlack; // Same, for the last complete scanout frame
+    volatile uint32_t scanUnderruns;    // Bounce buffers filled after their deadline
+#endif
+    int width;
+    int height;
+} PanelData;
+
+//----------------------------------------------------------------------------------
+// Global Variables Definition
+//----------------------------------------------------------------------------------
+static PanelData panel = { 0 };
+
+//----------------------------------------------------------------------------------
+// Module Internal Functions
+//----------------------------------------------------------------------------------
+
+IRAM_ATTR static bool PanelColorTransDone(esp_lcd_panel_io_handle_t io, esp_lcd_panel_io_event_data_t *edata, void *ctx)
+{
+    BaseType_t woken = pdFALSE;
+    xSemaphoreGiveFromISR(panel.free, &woken);
+    return (woken == pdTRUE);
+}
+
+#if PANEL_RGB_FRAME_BUFFERS
+IRAM_ATTR static bool PanelVsync(esp_lcd_panel_handle_t handle, const esp_lcd_rgb_panel_event_data_t *edata, void *ctx)
+{
+    BaseType_t woken = pdFALSE;
+    xSemaphoreGiveFromISR(panel.vsync, &woken);
+    return (woken == pdTRUE);
+}
+
+static bool PanelFrameBuffersInit(void)
+{
+    int count = panel.config.rgb_frame_buffers;
+    if (count > ESP_PANEL_MAX_RGB_FRAME_BUFFERS) count = ESP_PANEL_MAX_RGB_FRAME_BUFFERS;
+
+    void *fbs[3] = { 0 };
+    if (esp_lcd_rgb_panel_get_frame_buffer(panel.panel, count, &fbs[0], &fbs[1], &fbs[2]) != ESP_OK) {
+        TRACELOG(LOG_ERROR, "PANEL: Failed to get %d RGB panel frame buffers (check the panel num_fbs)", count);
+        return false;
+    }
+    for (int i = 0; i < count; i++) panel.frameBuffers[i] = fbs[i];
+
+    panel.vsync = xSemaphoreCreateBinary();
+    if (!panel.vsync) return false;
+
+    esp_lcd_rgb_panel_event_callbacks_t cbs = { .on_vsync = PanelVsync };
+    if (esp_lcd_rgb_panel_register_event_callbacks(panel.panel, &cbs, NULL) != ESP_OK) {
+        TRACELOG(LOG_ERROR, "PANEL: Failed to register RGB panel callbacks");
+        EspPanelClose();
+        return false;
+    }
+
+    // Scanout starts on the first frame buffer
+    panel.frameBufferCount = count;
+    panel.back = (count > 1)? 1 : 0;
+    panel.swapPending = false;
+
+    TRACELOG(LOG_INFO, "PANEL: Presenting into %d RGB panel frame buffers", count);
+    return true;
+}
+
+// Fill one bounce buffer from the presented frame: the buffer is scanned out right after the
+// one the DMA has just started, so the time since the previous callback is the fill budget.
+// Runs in the ISR: the copies are the scalar IRAM kernels, never the PIE ones
+IRAM_ATTR static bool PanelBounceEmpty(esp_lcd_panel_handle_t handle, void *buf, int posPx, int lenBytes, void *ctx)
+{
+    int64_t start = esp_timer_get_time();
+    uint16_t *dst = buf;
+    int count = lenBytes / (int)sizeof(uint16_t);
+    const uint16_t *first = panel.scanFirst;
+    int rowStep = panel.scanRowStep;
+
+    while (count > 0) {
+        int y = (posPx / panel.width) % panel.height;
+        int x = posPx % panel.width;
+        int run = panel.width - x;
+        if (run > count) run = count;
+
+        if (!first) memset(dst, 0, run * sizeof(uint16_t));
+        else if (panel.config.swap_bytes) EspPixelSwapCopyIsr(dst, first + (y * rowStep) + x, run);
+        else EspPixelCopyIsr(dst, first + (y * rowStep) + x, run);
+
+        dst += run;
+        posPx += run;
+        count -= run;
+    }
+
+    int64_t end = esp_timer_get_time();
+    if (panel.scanLastFill > 0) {
+        int32_t slack = (int32_t)((start - panel.scanLastFill) - (end - start));
+        if (slack < panel.scanMinSlack) panel.scanMinSlack = slack;
+        if (slack < 0) panel.scanUnderruns++;
+    }
+    panel.scanLastFill = start;
+
+    return false;
+}
+
+IRAM_ATTR static bool PanelBounceFrameFinish(esp_lcd_panel_handle_t handle, const esp_lcd_rgb_panel_event_data_t *edata, void *ctx)
+{
+    // The first fill of the next frame also covers the blanking interval, not a deadline
+    panel.scanLastFill = 0;
+    panel.scanFrameMinSlack = panel.scanMinSlack;
+    panel.scanMinSlack = INT32_MAX;
+
+    BaseType_t woken = pdFALSE;
+    xSemaphoreGiveFromISR(panel.vsync, &woken);
+    return (woken == pdTRUE);
+}
+
+static bool PanelScanoutInit(void)
+{
+    // The bounce callback reads the PSRAM color buffer: with an IRAM-safe LCD ISR it also runs
+    // while flash is written, when PSRAM is only reachable if it does not share the flash cache
+#if CONFIG_LCD_RGB_ISR_IRAM_SAFE && !(CONFIG_SPIRAM_XIP_FROM_PSRAM || (CONFIG_SPIRAM_FETCH_INSTRUCTIONS && CONFIG_SPIRAM_RODATA))
+    TRACELOG(LOG_ERROR, "PANEL: RGB bounce scanout with CONFIG_LCD_RGB_ISR_IRAM_SAFE needs CONFIG_SPIRAM_XIP_FROM_PSRAM");
+    return false;
+#elif !CONFIG_LCD_RGB_ISR_IRAM_SAFE
+    TRACELOG(LOG_WARNING, "PANEL: CONFIG_LCD_RGB_ISR_IRAM_SAFE is off, scanout stalls (underruns) while flash is written");
+#endif
+
+    panel.vsync = xSemaphoreCreateBinary();
+    if (!panel.vsync) return false;
+
+    panel.scanFirst = NULL;
+    panel.scanLastFill = 0;
+    panel.scanMinSlack = INT32_MAX;
+    panel.scanFrameMinSlack = INT32_MAX;
+    panel.scanUnderruns = 0;
+
+    esp_lcd_rgb_panel_event_callbacks_t cbs = {
+        .on_bounce_empty = PanelBounceEmpty,
+        .on_bounce_frame_finish = PanelBounceFrameFinish,
+    };
+    if (esp_lcd_rgb_panel_register_event_callbacks(panel.panel, &cbs, NULL) != ESP_OK) {
+        TRACELOG(LOG_ERROR, "PANEL: Failed to register RGB panel bounce callbacks");
+        EspPanelClose();
+        return false;
+    }
+
+    panel.scanout = true;
+    TRACELOG(LOG_INFO, "PANEL: Scanning out of the color buffer through RGB panel bounce buffers");
+    return true;
+}
+
+static void FrameBufferDraw(const uint16_t *first, int rowStep, EspRect rect)
+{
+    if (panel.swapPending) {
+        xSemaphoreTake(panel.vsync, portMAX_DELAY);
+        panel.swapPending = false;
+    }
+
+    uint16_t *dst = panel.frameBuffers[panel.back] + (rect.y * panel.width) + rect.x;
+    EspPixelCopyRows(dst, panel.width, first, rowStep, rect.width, rect.height, panel.config.swap_bytes);
+}
+#endif
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition
+//----------------------------------------------------------------------------------
+
+esp_err_t raylib_esp_set_panel(esp_lcd_panel_handle_t handle, esp_lcd_panel_io_handle_t io, const raylib_esp_panel_config_t *config)
+{
+    if (!handle || !config) return ESP_ERR_INVALID_ARG;
+
+    panel.panel = handle;
+    panel.io = io;
+    panel.config = *config;
+    return ESP_OK;
+}
+
+bool EspPanelAttached(void)
+{
+    return (panel.panel != NULL);
+}
+
+bool EspPanelInit(int width, int height)
+{
+    if (!panel.panel) return true;
+
+    panel.width = width;
+    panel.height = height;
+
+#if PANEL_RGB_FRAME_BUFFERS
+    if (panel.config.rgb_bounce_scanout) return PanelScanoutInit();
+    if (panel.config.rgb_frame_buffers > 0) return PanelFrameBuffersInit();
+#endif
+
+    size_t rowBytes = width * sizeof(uint16_t);
+    int lines = (panel.config.max_transfer_sz >= rowBytes)? (int)(panel.config.max_transfer_sz / rowBytes) : 1;
+    panel.bouncePixels = lines * width;
+
+    // One buffer being filled while the others are queued on the panel IO, a single buffer
+    // is enough when draw_bitmap() copies synchronously
+    int count = panel.config.trans_queue_depth;
+    if (count < 2) count = 2;
+    if (count > ESP_PANEL_MAX_BOUNCE_BUFFERS) count = ESP_PANEL_MAX_BOUNCE_BUFFERS;
+    if (!panel.io) count = 1;
+
+    for (int i = 0; i < count; i++) {
+        panel.bounce[i] = heap_caps_malloc(panel.bouncePixels * sizeof(uint16_t), MALLOC_CAP_DMA | MALLOC_CAP_INTERNAL);
+        if (!panel.bounce[i]) {
+            TRACELOG(LOG_ERROR, "PANEL: Failed to allocate bounce buffer %d (%d lines)", i, lines);
+            EspPanelClose();
+            return false;
+        }
+        panel.bounceCount++;
+    }
+    panel.next = 0;
+
+    panel.free = xSemaphoreCreateCounting(count, count);
+    if (!panel.free) {
+        EspPanelClose();
+        return false;
+    }
+
+    if (panel.io) {
+        esp_lcd_panel_io_callbacks_t cbs = { .on_color_trans_done = PanelColorTransDone };
+        if (esp_lcd_panel_io_register_event_callbacks(panel.io, &cbs, NULL) != ESP_OK) {
+            TRACELOG(LOG_ERROR, "PANEL: Failed to register panel IO callbacks");
+            EspPanelClose();
+            return false;
+        }
+    }
+
+    TRACELOG(LOG_INFO, "PANEL: Present stage ready (%d x %d lines bounce buffers)", count, lines);
+    return true;
+}
+
+// Scanout reads the presented frame directly, available before EspPanelInit()
+bool EspPanelScanout(void)
+{
+#if PANEL_RGB_FRAME_BUFFERS
+    return (panel.panel != NULL) && panel.config.rgb_bounce_scanout;
+#else
+    return false;
+#endif
+}
+
+void EspPanelScanoutStats(int32_t *minSlackUs, uint32_t *underruns)
+{
+#if PANEL_RGB_FRAME_BUFFERS
+    *minSlackUs = (panel.scanFrameMinSlack == INT32_MAX)? 0 : panel.scanFrameMinSlack;
+    *underruns = panel.scanUnderruns;
+#else
+    *minSlackUs = 0;
+    *underruns = 0;
+#endif
+}
+
+int EspPanelFrameBufferCount(void)
+{
+#if PANEL_RGB_FRAME_BUFFERS
+    return panel.frameBufferCount;
+#else
+    return 0;
+#endif
+}
+
+void EspPanelClose(void)
+{
+#if PANEL_RGB_FRAME_BUFFERS
+    if (panel.vsync) {
+        // Let a queued swap land before the panel buffers are reused
+        if (panel.swapPending) xSemaphoreTake(panel.vsync, portMAX_DELAY);
+
+        // Scanout keeps running on black once the color buffer goes away
+        panel.scanFirst = NULL;
+        esp_lcd_rgb_panel_event_callbacks_t cbs = { .on_bounce_empty = panel.scanout? PanelBounceEmpty : NULL };
+        esp_lcd_rgb_panel_register_event_callbacks(panel.panel, &cbs, NULL);
+        vSemaphoreDelete(panel.vsync);
+        panel.vsync = NULL;
+    }
+    panel.frameBufferCount = 0;
+    panel.swapPending = false;
+    panel.scanout = false;
+#endif
+
+    if (panel.free) {
+        // Wait until the DMA releases every bounce buffer
+        for (int i = 0; i < panel.bounceCount; i++) xSemaphoreTake(panel.free, portMAX_DELAY);
+
+        vSemaphoreDelete(panel.free);
+        panel.free = NULL;
+    }
+
+    for (int i = 0; i < panel.bounceCount; i++) {
+        heap_caps_free(panel.bounce[i]);
+        panel.bounce[i] = NULL;
+    }
+    panel.bounceCount = 0;
+}
+
+// Draw one screen region, first points at the region top-left pixel, rowStep (in pixels,
+// negative for bottom-up sources) moves one screen row down
+void EspPanelDraw(const uint16_t *first, int rowStep, EspRect rect)
+{
+#if PANEL_RGB_FRAME_BUFFERS
+    if (panel.frameBufferCount > 0) {
+        FrameBufferDraw(first, rowStep, rect);
+        return;
+    }
+
+    // Scanout only needs to know where the frame is, rect always covers the full screen
+    if (panel.scanout) {
+        panel.scanRowStep = rowStep;
+        panel.scanFirst = first;
+        return;
+    }
+#endif
+
+    // Narrow regions fit more lines per transfer
+    int chunkLines = panel.bouncePixels / rect.width;
+
+    for (int y = 0; y < rect.height; y += chunkLines) {
+        int lines = (y + chunkLines > rect.height)? rect.height - y : chunkLines;
+
+        xSemaphoreTake(panel.free, portMAX_DELAY);
+        uint16_t *dst = panel.bounce[panel.next];
+        panel.next = (panel.next + 1) % panel.bounceCount;
+
+        // Flip and byte swap in one pass, swapping RGB565 bytes for big-endian panels
+        EspPixelCopyRows(dst, rect.width, first + (y * rowStep), rowStep, rect.width, lines, panel.config.swap_bytes);
+
+        esp_err_t ret = esp_lcd_panel_draw_bitmap(panel.panel, rect.x, rect.y + y, rect.x + rect.width, rect.y + y + lines, dst);
+
+        // Without panel IO callbacks the draw is complete on return
+        if ((ret != ESP_OK) || !panel.io) xSemaphoreGive(panel.free);
+
+        if (ret != ESP_OK) {
+            ESP_LOGE("RAYLIB", "Failed to draw bitmap chunk at row %d: %s", rect.y + y, esp_err_to_name(ret));
+            return;
+        }
+    }
+}
+
+// All regions of the frame are drawn, RGB panels switch to the filled frame buffer
+void EspPanelFrameEnd(void)
+{
+#if PANEL_RGB_FRAME_BUFFERS
+    if (panel.scanout) {
+        // Pace rendering to the refresh rate, the next frame starts as a scanout pass begins
+        xSemaphoreTake(panel.vsync, 0);
+        xSemaphoreTake(panel.vsync, portMAX_DELAY);
+        return;
+    }
+
+    if (panel.frameBufferCount == 0) return;
+
+    // Drop vsyncs from before the swap is queued, the next one given is the swap's
+    if (panel.frameBufferCount > 1) xSemaphoreTake(panel.vsync, 0);
+
+    // draw_bitmap() of a panel frame buffer only writes back the cache and queues the swap
+    esp_err_t ret = esp_lcd_panel_draw_bitmap(panel.panel, 0, 0, panel.width, panel.height, panel.frameBuffers[panel.back]);
+    if (ret != ESP_OK) {
+        ESP_LOGE("RAYLIB", "Failed to swap RGB panel frame buffer: %s", esp_err_to_name(ret));
+        return;
+    }
+
+    if (panel.frameBufferCount > 1) {
+        panel.swapPending = true;
+        panel.back = (panel.back + 1) % panel.frameBufferCount;
+    }
+#endif
+}
+
+void raylib_esp_panel_flush(const uint16_t *buf, uint16_t x, uint16_t y, uint16_t w, uint16_t h)
+{
+    if (!buf || (w == 0) || (h == 0)) return;
+
+    if (!panel.free && (EspPanelFrameBufferCount() == 0)) {
+        if (EspPanelScanout()) ESP_LOGE("RAYLIB", "raylib_esp_panel_flush() not available in RGB bounce scanout mode");
+        else ESP_LOGE("RAYLIB", "Panel present stage not initialized, call raylib_esp_set_panel() before InitWindow()");
+        return;
+    }
+
+    EspPanelDraw(buf, w, (EspRect){ x, y, w, h });
+}
@@ -0,0 +1,277 @@
+/**********************************************************************************************
+*
+*   rpixel_esp_idf - RGB565 pixel kernels for the ESP-IDF present path
+*
+*   Row copy, byte-swap copy and flipped (negative row step) copies of both, used when
+*   packing present buffers and filling panel bounce buffers; solid and alpha-blended span
+*   fills used by the rectangle fast path; color-keyed and blended row blits used by the
+*   texture fast path; glyph mask spans used by the text fast path
+*
+*   On ESP32-S3 the bulk of each row can run on the PIE 128-bit SIMD unit (16 pixels per
+*   iteration for swaps, byte lanes exchanged with EE.VUNZIP.8/EE.VZIP.8, see
+*   rpixel_pie_esp_idf.S); unaligned heads and tails, and other targets, use a portable
+*   32-bit SWAR path. The PIE paths are off by default (SUPPORT_ESP_PIE_KERNELS), test/host
+*   checks the portable paths and test/target the PIE ones against scalar references
+*
+*   The panel scanout ISR uses separate scalar copies placed in IRAM: PIE registers are not
+*   saved on interrupt entry, and flash-resident code cannot run while the cache is disabled
+*
+**********************************************************************************************/
+
+#include "config.h"
+#include "raylib.h"
+#include "rlgl.h"
+#include "esp_idf_internal.h"
+#include <string.h>
+
+#include "sdkconfig.h"
+#include "esp_attr.h"
+
+#if SUPPORT_ESP_PIE_KERNELS && CONFIG_IDF_TARGET_ESP32S3
+    #define PIXEL_USE_PIE   1
+#else
+    #define PIXEL_USE_PIE   0
+#endif
+
+//----------------------------------------------------------------------------------
+// Module Internal Functions
+//----------------------------------------------------------------------------------
+
+// Scalar byte-swap copy, heads and tails of the wider kernels
+static void SwapCopyScalar(uint16_t *dst, const uint16_t *src, int count)
+{
+    for (int i = 0; i < count; i++) dst[i] = __builtin_bswap16(src[i]);
+}
+
+// Portable swap: two pixels per 32-bit word once dst is word aligned
+static void SwapCopyPortable(uint16_t *dst, const uint16_t *src, int count)
+{
+    if ((((uintptr_t)dst & 2) != 0) && (count > 0)) {
+        *dst++ = __builtin_bswap16(*src++);
+        count--;
+    }
+
+    if (((uintptr_t)src & 3) == 0) {
+        for (; count >= 2; count -= 2, dst += 2, src += 2) {
+            uint32_t word = 0;
+            memcpy(&word, src, sizeof(word));
+            word = ((word << 8) & 0xFF00FF00u) | ((word >> 8) & 0x00FF00FFu);
+            memcpy(dst, &word, sizeof(word));
+        }
+    }
+
+    SwapCopyScalar(dst, src, count);
+}
+
+#if PIXEL_USE_PIE
+// Scalar head until dst is 16-byte aligned, returns pixels handled
+static int AlignHead(uint16_t *dst, const uint16_t *src, int count, bool swap)
+{
+    int head = (int)((16 - ((uintptr_t)dst & 15)) & 15)/2;
+    if (head > count) head = count;
+
+    if (swap) SwapCopyScalar(dst, src, head);
+    else memcpy(dst, src, head * sizeof(uint16_t));
+
+    return head;
+}
+#endif
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition
+//----------------------------------------------------------------------------------
+
+void EspPixelCopy(uint16_t *dst, const uint16_t *src, int count)
+{
+#if PIXEL_USE_PIE
+    if ((count >= 16) && ((((uintptr_t)dst ^ (uintptr_t)src) & 15) == 0)) {
+        int head = AlignHead(dst, src, count, false);
+        dst += head; src += head; count -= head;
+
+        int blocks = count/8;
+        EspPixelCopyPie(dst, src, blocks);
+        dst += blocks*8; src += blocks*8; count -= blocks*8;
+    }
+#endif
+    memcpy(dst, src, count * sizeof(uint16_t));
+}
+
+void EspPixelSwapCopy(uint16_t *dst, const uint16_t *src, int count)
+{
+#if PIXEL_USE_PIE
+    if ((count >= 32) && ((((uintptr_t)dst ^ (uintptr_t)src) & 15) == 0)) {
+        int head = AlignHead(dst, src, count, true);
+        dst += head; src += head; count -= head;
+
+        int blocks = count/16;
+        EspPixelSwapCopyPie(dst, src, blocks);
+        dst += blocks*16; src += blocks*16; count -= blocks*16;
+    }
+#endif
+    SwapCopyPortable(dst, src, count);
+}
+
+// Solid span: two pixels per 32-bit store once dst is word aligned
+void EspPixelFill(uint16_t *dst, uint16_t color, int count)
+{
+    if ((((uintptr_t)dst & 2) != 0) && (count > 0)) {
+        *dst++ = color;
+        count--;
+    }
+
+#if PIXEL_USE_PIE
+    if (count >= 16) {
+        int head = (int)((16 - ((uintptr_t)dst & 15)) & 15)/2;
+        for (int i = 0; i < head; i++) dst[i] = color;
+        dst += head; count -= head;
+
+        int blocks = count/8;
+        EspPixelFillPie(dst, &color, blocks);
+        dst += blocks*8; count -= blocks*8;
+    }
+#endif
+
+    uint32_t pair = ((uint32_t)color << 16) | color;
+    uint32_t *dst32 = (uint32_t *)dst;
+    for (; count >= 2; count -= 2) *dst32++ = pair;
+    if (count > 0) *(uint16_t *)dst32 = color;
+}
+
+// Blend one RGB565 pixel over another, channels spread over 32 bits so a single multiply
+// covers all three (alpha in 0..32)
+static inline uint32_t BlendPixel(uint32_t src, uint32_t dst, uint32_t alpha)
+{
+    src = (src | (src << 16)) & 0x07E0F81Fu;
+    dst = (dst | (dst << 16)) & 0x07E0F81Fu;
+    uint32_t out = (dst + (((src - dst) * alpha) >> 5)) & 0x07E0F81Fu;
+    return (out | (out >> 16)) & 0xFFFFu;
+}
+
+// Alpha-blended span (src over dst, alpha 0..255), pixel pairs read and written as one word
+void EspPixelBlend(uint16_t *dst, uint16_t color, int alpha, int count)
+{
+    uint32_t a = ((uint32_t)alpha + 4) >> 3;
+
+    if ((((uintptr_t)dst & 2) != 0) && (count > 0)) {
+        *dst = (uint16_t)BlendPixel(color, *dst, a);
+        dst++;
+        count--;
+    }
+
+    uint32_t *dst32 = (uint32_t *)dst;
+    for (; count >= 2; count -= 2, dst32++) {
+        uint32_t pair = *dst32;
+        *dst32 = BlendPixel(color, pair & 0xFFFFu, a) | (BlendPixel(color, pair >> 16, a) << 16);
+    }
+    if (count > 0) {
+        uint16_t *last = (uint16_t *)dst32;
+        *last = (uint16_t)BlendPixel(color, *last, a);
+    }
+}
+
+// Color-keyed row copy: pixels with alpha 0 are skipped, opaque runs are copied in bulk
+void EspPixelBlitKeyed(uint16_t *dst, const uint16_t *src, const uint8_t *alpha, int count)
+{
+    int i = 0;
+    while (i < count) {
+        while ((i < count) && (alpha[i] == 0)) i++;
+
+        int start = i;
+        while ((i < count) && (alpha[i] != 0)) i++;
+        if (i > start) EspPixelCopy(dst + start, src + start, i - start);
+    }
+}
+
+// Alpha-blended row copy with tint (0xRRGGBBAA, as ColorToInt()), alpha NULL for opaque sources
+void EspPixelBlitBlend(uint16_t *dst, const uint16_t *src, const uint8_t *alpha, uint32_t tint, int count)
+{
+    uint32_t tr = (tint >> 24) + 1, tg = ((tint >> 16) & 0xFF) + 1, tb = ((tint >> 8) & 0xFF) + 1, ta = (tint & 0xFF) + 1;
+    bool white = (tint | 0xFF) == 0xFFFFFFFFu;
+
+    for (int i = 0; i < count; i++) {
+        uint32_t a = alpha? ((alpha[i]*ta) >> 8) : (ta - 1);
+        if (a == 0) continue;
+
+        uint32_t c = src[i];
+        if (!white) {
+            c = ((((c >> 11)*tr) >> 8) << 11) | (((((c >> 5) & 0x3F)*tg) >> 8) << 5) | (((c & 0x1F)*tb) >> 8);
+        }
+
+        dst[i] = (a == 255)? (uint16_t)c : (uint16_t)BlendPixel(c, dst[i], (a + 4) >> 3);
+    }
+}
+
+// Glyph mask span: color blended by mask coverage times alpha, fully covered runs filled
+void EspPixelMask(uint16_t *dst, const uint8_t *mask, uint16_t color, int alpha, int count)
+{
+    uint32_t scale = (uint32_t)alpha + 1;
+
+    int i = 0;
+    while (i < count) {
+        if (mask[i] == 0) {
+            i++;
+        } else if ((mask[i] == 255) && (alpha == 255)) {
+            int start = i;
+            while ((i < count) && (mask[i] == 255)) i++;
+            EspPixelFill(dst + start, color, i - start);
+        } else {
+            uint32_t a = (mask[i]*scale) >> 8;
+            dst[i] = (uint16_t)BlendPixel(color, dst[i], (a + 4) >> 3);
+            i++;
+        }
+    }
+}
+
+// Copy rows into dst (dstStride pixels apart), first is the top-left source pixel and rowStep
+// moves one screen row down (negative for bottom-up sources, i.e. flipped copies)
+void EspPixelCopyRows(uint16_t *dst, int dstStride, const uint16_t *first, int rowStep, int width, int rows, bool swap)
+{
+    for (int row = 0; row < rows; row++) {
+        if (swap) EspPixelSwapCopy(dst, first, width);
+        else EspPixelCopy(dst, first, width);
+
+        dst += dstStride;
+        first += rowStep;
+    }
+}
+
+// ISR copy (no PIE, IRAM resident): 32-bit words when dst and src share word alignment
+IRAM_ATTR void EspPixelCopyIsr(uint16_t *dst, const uint16_t *src, int count)
+{
+    if ((((uintptr_t)dst ^ (uintptr_t)src) & 2) == 0) {
+        if ((((uintptr_t)dst & 2) != 0) && (count > 0)) {
+            *dst++ = *src++;
+            count--;
+        }
+
+        uint32_t *dst32 = (uint32_t *)dst;
+        const uint32_t *src32 = (const uint32_t *)src;
+        for (; count >= 2; count -= 2) *dst32++ = *src32++;
+        dst = (uint16_t *)dst32;
+        src = (const uint16_t *)src32;
+    }
+
+    for (; count > 0; count--) *dst++ = *src++;
+}
+
+// ISR byte-swap copy (no PIE, IRAM resident), same word path as EspPixelCopyIsr()
+IRAM_ATTR void EspPixelSwapCopyIsr(uint16_t *dst, const uint16_t *src, int count)
+{
+    if ((((uintptr_t)dst ^ (uintptr_t)src) & 2) == 0) {
+        if ((((uintptr_t)dst & 2) != 0) && (count > 0)) {
+            *dst++ = __builtin_bswap16(*src++);
+            count--;
+        }
+
+        uint32_t *dst32 = (uint32_t *)dst;
+        const uint32_t *src32 = (const uint32_t *)src;
+        for (; count >= 2; count -= 2) {
+            uint32_t word = *src32++;
+            *dst32++ = ((word << 8) & 0xFF00FF00u) | ((word >> 8) & 0x00FF00FFu);
+        }
+        dst = (uint16_t *)dst32;
+        src = (const uint16_t *)src32;
+    }
+
+    for (; count > 0; count--) *dst++ = __builtin_bswap16(*src++);
+}
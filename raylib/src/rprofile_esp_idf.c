@@ -0,0 +1,181 @@
+/**********************************************************************************************
+*
+*   rprofile_esp_idf - Per-phase frame profiler for ESP-IDF
+*
+*   Phases are bracketed with ESP_PROFILE_BEGIN()/ESP_PROFILE_END() (esp_idf_internal.h) and
+*   timed with the CPU cycle counter (a monotonic clock when built for the host). Time spent
+*   in each phase is summed over the frame, since bands and rectangles run a phase many times,
+*   and every frame is pushed into a ring of the last ESP_PROFILE_FRAMES frames that
+*   raylib_esp_get_frame_stats() summarizes as min/avg/p99/max
+*
+*   With SUPPORT_ESP_PROFILER 0 the markers expand to nothing and only the stats stub remains
+*
+**********************************************************************************************/
+
+#include "config.h"
+#include "raylib.h"
+#include "rlgl.h"
+#include "esp_idf_internal.h"
+#include "raylib_esp.h"
+#include <string.h>
+
+#if SUPPORT_ESP_PROFILER
+#if defined(ESP_PLATFORM)
+    #include "esp_cpu.h"
+    #include "esp_rom_sys.h"
+#else
+    #include <time.h>
+#endif
+
+//----------------------------------------------------------------------------------
+// Types and Structures
+//----------------------------------------------------------------------------------
+typedef struct {
+    uint32_t start[RAYLIB_ESP_PHASE_COUNT];     // Tick count at ESP_PROFILE_BEGIN()
+    int core[RAYLIB_ESP_PHASE_COUNT];           // Core the phase began on (cycle counters are per core)
+    uint32_t ticks[RAYLIB_ESP_PHASE_COUNT];     // Sum over the current frame
+    uint32_t ring[ESP_PROFILE_FRAMES][RAYLIB_ESP_PHASE_COUNT];     // Microseconds per frame
+    uint32_t frames;                            // Frames recorded since InitWindow()
+} ProfileData;
+
+//----------------------------------------------------------------------------------
+// Global Variables Definition
+//----------------------------------------------------------------------------------
+static ProfileData profile = { 0 };
+
+#if ESP_PROFILE_LOG_INTERVAL > 0
+static const char *PHASE_NAMES[RAYLIB_ESP_PHASE_COUNT] = { "draw", "replay", "copy", "flush", "pace", "frame" };
+#endif
+
+//----------------------------------------------------------------------------------
+// Module Internal Functions
+//----------------------------------------------------------------------------------
+
+static inline uint32_t ProfileTicks(void)
+{
+#if defined(ESP_PLATFORM)
+    return esp_cpu_get_cycle_count();
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32_t)((uint64_t)ts.tv_sec*1000000000u + ts.tv_nsec);
+#endif
+}
+
+static inline int ProfileCore(void)
+{
+#if defined(ESP_PLATFORM)
+    return esp_cpu_get_core_id();
+#else
+    return 0;
+#endif
+}
+
+static uint32_t TicksPerUs(void)
+{
+#if defined(ESP_PLATFORM)
+    return esp_rom_get_cpu_ticks_per_us();
+#else
+    return 1000;
+#endif
+}
+
+static void SortSamples(uint32_t *values, int count)
+{
+    for (int i = 1; i < count; i++) {
+        uint32_t v = values[i];
+        int j = i;
+        while ((j > 0) && (values[j - 1] > v)) {
+            values[j] = values[j - 1];
+            j--;
+        }
+        values[j] = v;
+    }
+}
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition
+//----------------------------------------------------------------------------------
+
+void EspProfileBegin(int phase)
+{
+    profile.core[phase] = ProfileCore();
+    profile.start[phase] = ProfileTicks();
+}
+
+void EspProfileEnd(int phase)
+{
+    uint32_t elapsed = ProfileTicks() - profile.start[phase];
+
+    // The task moved to the other core, its cycle counter is unrelated: drop the sample
+    if (ProfileCore() != profile.core[phase]) return;
+
+    // Flushes may end on the present task while the render task ends its own phases
+    __atomic_fetch_add(&profile.ticks[phase], elapsed, __ATOMIC_RELAXED);
+}
+
+void EspProfileFrame(void)
+{
+    uint32_t perUs = TicksPerUs();
+    uint32_t *slot = profile.ring[profile.frames % ESP_PROFILE_FRAMES];
+
+    for (int i = 0; i < RAYLIB_ESP_PHASE_COUNT; i++) {
+        slot[i] = __atomic_exchange_n(&profile.ticks[i], 0, __ATOMIC_RELAXED)/perUs;
+    }
+    profile.frames++;
+
+#if ESP_PROFILE_LOG_INTERVAL > 0
+    if (profile.frames % ESP_PROFILE_LOG_INTERVAL == 0) {
+        raylib_esp_frame_stats_t stats = { 0 };
+        raylib_esp_get_frame_stats(&stats);
+
+        for (int i = 0; i < RAYLIB_ESP_PHASE_COUNT; i++) {
+            const raylib_esp_phase_stats_t *p = &stats.phases[i];
+            TRACELOG(LOG_INFO, "PROFILE: %-6s min %6lu avg %6lu p99 %6lu max %6lu us", PHASE_NAMES[i],
+                     (unsigned long)p->min_us, (unsigned long)p->avg_us, (unsigned long)p->p99_us, (unsigned long)p->max_us);
+        }
+    }
+#endif
+}
+
+void EspProfileReset(void)
+{
+    memset(&profile, 0, sizeof(profile));
+}
+#endif // SUPPORT_ESP_PROFILER
+
+//----------------------------------------------------------------------------------
+// Public API
+//----------------------------------------------------------------------------------
+
+bool raylib_esp_get_frame_stats(raylib_esp_frame_stats_t *stats)
+{
+    if (!stats) return false;
+    memset(stats, 0, sizeof(*stats));
+
+#if SUPPORT_ESP_PROFILER
+    int count = (profile.frames < ESP_PROFILE_FRAMES)? (int)profile.frames : ESP_PROFILE_FRAMES;
+    stats->frames = (uint32_t)count;
+    if (count == 0) return true;
+
+    uint32_t values[ESP_PROFILE_FRAMES];
+    for (int phase = 0; phase < RAYLIB_ESP_PHASE_COUNT; phase++) {
+        uint64_t sum = 0;
+        for (int i = 0; i < count; i++) {
+            values[i] = profile.ring[i][phase];
+            sum += values[i];
+        }
+        SortSamples(values, count);
+
+        raylib_esp_phase_stats_t *p = &stats->phases[phase];
+        p->min_us = values[0];
+        p->avg_us = (uint32_t)(sum/count);
+        p->p99_us = values[(count*99 + 99)/100 - 1];
+        p->max_us = values[count - 1];
+    }
+
+    return true;
+#else
+    return false;
+#endif
+}
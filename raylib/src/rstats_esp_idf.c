@@ -0,0 +1,331 @@
+/**********************************************************************************************
+*
+*   rstats_esp_idf - Renderer statistics and overdraw heatmap for ESP-IDF
+*
+*   rlgl primitives are counted from the interposed vertex functions (rlgl_esp_idf.c): vertices
+*   arrive in screen space, are assembled into triangles like rlsw does (quads split in two) and
+*   each triangle is either rejected (degenerate, off screen or scissored out) or its covered
+*   pixel centers are counted as fragments. The span fast paths report the rectangles they write
+*
+*   With the overdraw heatmap enabled every counted fragment also increments a per-pixel counter,
+*   and before presenting the screen is overwritten with a color per overdraw level
+*
+**********************************************************************************************/
+
+#include "config.h"
+#include "raylib.h"
+#include "rlgl.h"
+#include "esp_idf_internal.h"
+#include "raylib_esp.h"
+#include <math.h>
+#include <string.h>
+
+#include "esp_log.h"
+#include "esp_heap_caps.h"
+
+#if SUPPORT_ESP_RENDER_STATS
+//----------------------------------------------------------------------------------
+// Types and Structures
+//----------------------------------------------------------------------------------
+typedef struct {
+    raylib_esp_render_stats_t frame;    // Counting since BeginDrawing()
+    raylib_esp_render_stats_t last;     // Last presented frame
+    uint32_t frames;
+
+    int mode;                   // Current primitive mode, counted per triangle or line
+    bool screenSpace;           // Vertices are screen coordinates, fragments can be counted
+    EspRect clip;               // Screen or scissor rectangle of the current primitive
+    float vx[4], vy[4];         // Pending vertices of the current triangle, quad or line
+    int vertexCount;
+    unsigned char alpha;        // Current vertex color alpha
+    unsigned int texture;       // Bound texture, 0 for none
+    unsigned int lastTexture;   // Last texture bound, for switch counting
+
+    bool heatmap;               // Set by the application, applied at BeginDrawing()
+    uint8_t *heat;              // Fragments per pixel this frame, top row first
+    int heatWidth;
+    int heatHeight;
+} RenderStats;
+
+//----------------------------------------------------------------------------------
+// Global Variables Definition
+//----------------------------------------------------------------------------------
+static RenderStats stats = { .alpha = 255 };
+
+// Heatmap colors by fragments per pixel: none, 1 (no overdraw), 2, 3, 4, 5-7, 8 or more
+static const Color HEAT_COLORS[] = {
+    { 0, 0, 0, 255 }, { 0, 0, 160, 255 }, { 0, 160, 0, 255 }, { 200, 200, 0, 255 },
+    { 255, 128, 0, 255 }, { 255, 0, 0, 255 }, { 255, 255, 255, 255 },
+};
+
+//----------------------------------------------------------------------------------
+// Module Internal Functions
+//----------------------------------------------------------------------------------
+
+static void HeatRow(int x0, int x1, int y)
+{
+    uint8_t *row = stats.heat + y*stats.heatWidth;
+    for (int x = x0; x < x1; x++) {
+        if (row[x] < 255) row[x]++;
+    }
+}
+
+static bool HeatReady(void)
+{
+    return stats.heat && (stats.heatWidth == GetScreenWidth()) && (stats.heatHeight == GetScreenHeight());
+}
+
+// Blending is skipped only for opaque vertex colors sampling an opaque texture (or none)
+static bool Blended(void)
+{
+    if (stats.alpha < 255) return true;
+    if (stats.texture == 0) return false;
+
+    const EspTextureShadow *tex = EspTextureFind(stats.texture);
+    return !tex || (tex->kind != ESP_TEXTURE_OPAQUE);
+}
+
+static bool TopLeft(float ax, float ay, float bx, float by)
+{
+    return (by < ay) || ((by == ay) && (bx > ax));
+}
+
+static void CountTriangle(float x0, float y0, float x1, float y1, float x2, float y2)
+{
+    stats.frame.triangles++;
+    if (!stats.screenSpace) return;
+
+    float area = (x1 - x0)*(y2 - y0) - (x2 - x0)*(y1 - y0);
+    float minX = fminf(x0, fminf(x1, x2)), maxX = fmaxf(x0, fmaxf(x1, x2));
+    float minY = fminf(y0, fminf(y1, y2)), maxY = fmaxf(y0, fmaxf(y1, y2));
+
+    // Pixel centers inside the bounds, cut to the clip rectangle
+    int px0 = (int)ceilf(minX - 0.5f), px1 = (int)ceilf(maxX - 0.5f);
+    int py0 = (int)ceilf(minY - 0.5f), py1 = (int)ceilf(maxY - 0.5f);
+    bool inside = (px0 >= stats.clip.x) && (py0 >= stats.clip.y) &&
+                  (px1 <= stats.clip.x + stats.clip.width) && (py1 <= stats.clip.y + stats.clip.height);
+    if (px0 < stats.clip.x) px0 = stats.clip.x;
+    if (py0 < stats.clip.y) py0 = stats.clip.y;
+    if (px1 > stats.clip.x + stats.clip.width) px1 = stats.clip.x + stats.clip.width;
+    if (py1 > stats.clip.y + stats.clip.height) py1 = stats.clip.y + stats.clip.height;
+
+    if ((fabsf(area) < 1e-6f) || (px1 <= px0) || (py1 <= py0)) {
+        stats.frame.triangles_rejected++;
+        return;
+    }
+
+    bool heat = stats.heatmap && HeatReady();
+    uint32_t fragments = 0;
+
+    if (inside && !heat) {
+        // Unclipped: the area is the fragment count up to edge rounding
+        fragments = (uint32_t)(fabsf(area)*0.5f + 0.5f);
+    }
+    else {
+        // Edge functions at pixel centers with counter-clockwise winding, centers on an edge
+        // belong to its top or left side only so triangles sharing the edge count them once
+        if (area < 0.0f) {
+            float tx = x1, ty = y1;
+            x1 = x2; y1 = y2;
+            x2 = tx; y2 = ty;
+        }
+        float bias0 = TopLeft(x0, y0, x1, y1)? 0.0f : -1e-4f;
+        float bias1 = TopLeft(x1, y1, x2, y2)? 0.0f : -1e-4f;
+        float bias2 = TopLeft(x2, y2, x0, y0)? 0.0f : -1e-4f;
+
+        for (int y = py0; y < py1; y++) {
+            float cy = (float)y + 0.5f;
+            int runStart = -1;
+
+            for (int x = px0; x <= px1; x++) {
+                bool covered = false;
+                if (x < px1) {
+                    float cx = (float)x + 0.5f;
+                    float w0 = (x1 - x0)*(cy - y0) - (y1 - y0)*(cx - x0);
+                    float w1 = (x2 - x1)*(cy - y1) - (y2 - y1)*(cx - x1);
+                    float w2 = (x0 - x2)*(cy - y2) - (y0 - y2)*(cx - x2);
+                    covered = (w0 + bias0 >= 0.0f) && (w1 + bias1 >= 0.0f) && (w2 + bias2 >= 0.0f);
+                }
+
+                if (covered && (runStart < 0)) runStart = x;
+                else if (!covered && (runStart >= 0)) {
+                    fragments += (uint32_t)(x - runStart);
+                    if (heat) HeatRow(runStart, x, y);
+                    runStart = -1;
+                }
+            }
+        }
+    }
+
+    stats.frame.fragments += fragments;
+    if (Blended()) stats.frame.fragments_blended += fragments;
+}
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition
+//----------------------------------------------------------------------------------
+
+void EspStatsBegin(int mode, bool screenSpace, EspRect clip)
+{
+    stats.frame.primitives++;
+    stats.mode = mode;
+    stats.screenSpace = screenSpace;
+    stats.clip = clip;
+    stats.vertexCount = 0;
+}
+
+void EspStatsVertex(float x, float y)
+{
+    stats.vx[stats.vertexCount] = x;
+    stats.vy[stats.vertexCount] = y;
+    stats.vertexCount++;
+
+    const float *vx = stats.vx, *vy = stats.vy;
+    switch (stats.mode) {
+        case RL_LINES:
+            if (stats.vertexCount == 2) {
+                stats.frame.lines++;
+                stats.vertexCount = 0;
+            }
+            break;
+        case RL_TRIANGLES:
+            if (stats.vertexCount == 3) {
+                CountTriangle(vx[0], vy[0], vx[1], vy[1], vx[2], vy[2]);
+                stats.vertexCount = 0;
+            }
+            break;
+        case RL_QUADS:
+            if (stats.vertexCount == 4) {
+                CountTriangle(vx[0], vy[0], vx[1], vy[1], vx[2], vy[2]);
+                CountTriangle(vx[0], vy[0], vx[2], vy[2], vx[3], vy[3]);
+                stats.vertexCount = 0;
+            }
+            break;
+        default:
+            stats.vertexCount = 0;
+            break;
+    }
+}
+
+void EspStatsColor(unsigned char alpha)
+{
+    stats.alpha = alpha;
+}
+
+void EspStatsTexture(unsigned int id)
+{
+    stats.texture = id;
+
+    // rlgl unbinds after every textured shape, only a different texture is a switch
+    if ((id != 0) && (id != stats.lastTexture)) {
+        stats.frame.texture_switches++;
+        stats.lastTexture = id;
+    }
+}
+
+// Screen pixels [x0, x1) x [y0, y1) written by a fast path
+void EspStatsRect(int x0, int y0, int x1, int y1, bool blended)
+{
+    uint32_t fragments = (uint32_t)((x1 - x0)*(y1 - y0));
+
+    stats.frame.fragments += fragments;
+    if (blended) stats.frame.fragments_blended += fragments;
+
+    if (stats.heatmap && HeatReady()) {
+        for (int y = y0; y < y1; y++) HeatRow(x0, x1, y);
+    }
+}
+
+void EspStatsFastDraw(void)
+{
+    stats.frame.fast_draws++;
+}
+
+// Start counting a new frame (BeginDrawing())
+void EspStatsFrameBegin(void)
+{
+    memset(&stats.frame, 0, sizeof(stats.frame));
+    stats.lastTexture = 0;
+
+    if (!stats.heatmap) {
+        if (stats.heat) EspStatsClose();
+        return;
+    }
+
+    int width = GetScreenWidth(), height = GetScreenHeight();
+    if (!HeatReady()) {
+        heap_caps_free(stats.heat);
+        stats.heat = heap_caps_malloc(width*height, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+        stats.heatWidth = stats.heat? width : 0;
+        stats.heatHeight = stats.heat? height : 0;
+        if (!stats.heat) ESP_LOGE("RAYLIB", "Failed to allocate %d x %d overdraw heatmap", width, height);
+    }
+    if (stats.heat) memset(stats.heat, 0, width*height);
+}
+
+// Publish the frame counters and replace the frame with the overdraw heatmap before it is
+// presented (SwapScreenBuffer())
+void EspStatsFrameEnd(void)
+{
+    stats.last = stats.frame;
+    stats.last.frame = ++stats.frames;
+
+    if (!stats.heatmap || !HeatReady()) return;
+
+    int bufWidth = 0, bufHeight = 0;
+    uint16_t *buf = EspScreenTarget(&bufWidth, &bufHeight);
+    if (!buf) return;
+
+    uint16_t palette[sizeof(HEAT_COLORS)/sizeof(HEAT_COLORS[0])];
+    for (int i = 0; i < (int)(sizeof(palette)/sizeof(palette[0])); i++) {
+        Color c = HEAT_COLORS[i];
+        palette[i] = (uint16_t)(((c.r >> 3) << 11) | ((c.g >> 2) << 5) | (c.b >> 3));
+    }
+
+    bool topDown = EspTopDownEnabled();
+    for (int y = 0; y < bufHeight; y++) {
+        const uint8_t *heat = stats.heat + y*bufWidth;
+        uint16_t *dst = buf + ((topDown? y : bufHeight - 1 - y) * bufWidth);
+
+        for (int x = 0; x < bufWidth; x++) {
+            int level = heat[x];
+            dst[x] = palette[(level >= 8)? 6 : (level >= 5)? 5 : level];
+        }
+    }
+
+    if (EspDamageEnabled()) EspDamageAddFull();
+}
+
+void EspStatsClose(void)
+{
+    heap_caps_free(stats.heat);
+    stats.heat = NULL;
+    stats.heatWidth = stats.heatHeight = 0;
+}
+#endif // SUPPORT_ESP_RENDER_STATS
+
+//----------------------------------------------------------------------------------
+// Public API
+//----------------------------------------------------------------------------------
+
+bool raylib_esp_get_render_stats(raylib_esp_render_stats_t *out)
+{
+    if (!out) return false;
+
+#if SUPPORT_ESP_RENDER_STATS
+    *out = stats.last;
+    return true;
+#else
+    memset(out, 0, sizeof(*out));
+    return false;
+#endif
+}
+
+void raylib_esp_set_overdraw_heatmap(bool enable)
+{
+#if SUPPORT_ESP_RENDER_STATS
+    stats.heatmap = enable;
+#else
+    (void)enable;
+#endif
+}
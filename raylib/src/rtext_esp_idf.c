@@ -0,0 +1,163 @@
+/**********************************************************************************************
+*
+*   rtext_esp_idf - Glyph cache for ESP-IDF
+*
+*   Pre-scaled 8-bit alpha masks of font glyphs, keyed by font atlas, font size and glyph,
+*   built from the atlas texture shadow (rtexture_esp_idf.c) with the same nearest sampling
+*   rlsw applies to a scaled glyph quad. The text fast path (rlgl_esp_idf.c) blits the masks
+*   as tinted spans instead of issuing one textured quad per glyph
+*
+*   Masks live in a fixed internal RAM pool; once the pool or the entry table fills up the
+*   whole cache is dropped and rebuilt from the glyphs in use
+*
+**********************************************************************************************/
+
+#include "config.h"
+#include "raylib.h"
+#include "rlgl.h"
+#include "esp_idf_internal.h"
+#include <math.h>
+#include <string.h>
+
+#include "esp_heap_caps.h"
+
+//----------------------------------------------------------------------------------
+// Types and Structures
+//----------------------------------------------------------------------------------
+typedef struct {
+    unsigned int textureId;     // 0 marks an empty slot
+    float fontSize;
+    int index;
+    EspGlyph glyph;
+} GlyphEntry;
+
+typedef struct {
+    GlyphEntry entries[ESP_GLYPH_CACHE_ENTRIES];
+    int count;
+    uint8_t *pool;              // Mask storage (internal RAM)
+    int poolUsed;
+    bool poolFailed;            // Allocation failed once, keep using the general path
+} GlyphCache;
+
+//----------------------------------------------------------------------------------
+// Global Variables Definition
+//----------------------------------------------------------------------------------
+static GlyphCache cache = { 0 };
+
+//----------------------------------------------------------------------------------
+// Module Internal Functions
+//----------------------------------------------------------------------------------
+
+static unsigned int GlyphHash(unsigned int textureId, float fontSize, int index)
+{
+    uint32_t sizeBits = 0;
+    memcpy(&sizeBits, &fontSize, sizeof(sizeBits));
+    return (textureId*2654435761u) ^ (sizeBits*40503u) ^ ((uint32_t)index*2246822519u);
+}
+
+static bool PoolReady(void)
+{
+    if (cache.pool) return true;
+    if (cache.poolFailed) return false;
+
+    cache.pool = heap_caps_malloc(ESP_GLYPH_CACHE_BYTES, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    if (!cache.pool) {
+        TRACELOG(LOG_WARNING, "TEXT: Failed to allocate %d byte glyph cache, drawing text through rlgl", ESP_GLYPH_CACHE_BYTES);
+        cache.poolFailed = true;
+        return false;
+    }
+
+    return true;
+}
+
+// Nearest-sample the padded glyph rectangle at the destination pixel centers, pen at (0, 0)
+static bool GlyphBuild(EspGlyph *glyph, Font font, int index, float fontSize, const EspTextureShadow *atlas)
+{
+    float scale = fontSize/(float)font.baseSize;
+    float pad = (float)font.glyphPadding;
+    Rectangle rec = font.recs[index];
+
+    float srcX = rec.x - pad, srcY = rec.y - pad;
+    float srcWidth = rec.width + 2.0f*pad, srcHeight = rec.height + 2.0f*pad;
+    float dstX = ((float)font.glyphs[index].offsetX - pad)*scale;
+    float dstY = ((float)font.glyphs[index].offsetY - pad)*scale;
+    float dstWidth = srcWidth*scale, dstHeight = srcHeight*scale;
+
+    int x0 = (int)ceilf(dstX - 0.5f), x1 = (int)ceilf(dstX + dstWidth - 0.5f);
+    int y0 = (int)ceilf(dstY - 0.5f), y1 = (int)ceilf(dstY + dstHeight - 0.5f);
+    int width = (x1 > x0)? x1 - x0 : 0;
+    int height = (y1 > y0)? y1 - y0 : 0;
+
+    if (width*height > ESP_GLYPH_CACHE_BYTES) return false;
+    if (cache.poolUsed + width*height > ESP_GLYPH_CACHE_BYTES) EspGlyphCacheClear();
+
+    uint8_t *mask = cache.pool + cache.poolUsed;
+    cache.poolUsed += width*height;
+
+    for (int y = 0; y < height; y++) {
+        int v = (int)floorf(srcY + ((float)(y0 + y) + 0.5f - dstY)/dstHeight*srcHeight);
+        if (v < 0) v = 0;
+        if (v >= atlas->height) v = atlas->height - 1;
+
+        for (int x = 0; x < width; x++) {
+            int u = (int)floorf(srcX + ((float)(x0 + x) + 0.5f - dstX)/dstWidth*srcWidth);
+            if (u < 0) u = 0;
+            if (u >= atlas->width) u = atlas->width - 1;
+
+            mask[y*width + x] = atlas->alpha? atlas->alpha[v*atlas->width + u] : 255;
+        }
+    }
+
+    *glyph = (EspGlyph){ .x = x0, .y = y0, .width = width, .height = height, .mask = mask };
+    return true;
+}
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition
+//----------------------------------------------------------------------------------
+
+// Cached mask of glyph index at fontSize, NULL if the glyph must be drawn through rlgl
+const EspGlyph *EspGlyphFind(Font font, int index, float fontSize)
+{
+    const EspTextureShadow *atlas = EspTextureFind(font.texture.id);
+    if (!atlas || (!atlas->alpha && (atlas->kind != ESP_TEXTURE_OPAQUE)) || (font.baseSize <= 0) || !PoolReady()) return NULL;
+
+    unsigned int mask = ESP_GLYPH_CACHE_ENTRIES - 1;
+    unsigned int slot = GlyphHash(font.texture.id, fontSize, index) & mask;
+
+    while (cache.entries[slot].textureId != 0) {
+        GlyphEntry *entry = &cache.entries[slot];
+        if ((entry->textureId == font.texture.id) && (entry->fontSize == fontSize) && (entry->index == index)) return &entry->glyph;
+        slot = (slot + 1) & mask;
+    }
+
+    // Keep the table at most three quarters full so probing stays short
+    if (cache.count >= ESP_GLYPH_CACHE_ENTRIES*3/4) EspGlyphCacheClear();
+
+    EspGlyph glyph = { 0 };
+    if (!GlyphBuild(&glyph, font, index, fontSize, atlas)) return NULL;
+
+    // The table may have been cleared (above or when the pool filled up), probe again
+    slot = GlyphHash(font.texture.id, fontSize, index) & mask;
+    while (cache.entries[slot].textureId != 0) slot = (slot + 1) & mask;
+
+    cache.entries[slot] = (GlyphEntry){ .textureId = font.texture.id, .fontSize = fontSize, .index = index, .glyph = glyph };
+    cache.count++;
+
+    return &cache.entries[slot].glyph;
+}
+
+void EspGlyphCacheClear(void)
+{
+    memset(cache.entries, 0, sizeof(cache.entries));
+    cache.count = 0;
+    cache.poolUsed = 0;
+}
+
+void EspGlyphCacheClose(void)
+{
+    EspGlyphCacheClear();
+    heap_caps_free(cache.pool);
+    cache.pool = NULL;
+    cache.poolFailed = false;
+}
@@ -0,0 +1,571 @@
+/**********************************************************************************************
+*
+*   rtexture_esp_idf - Texture shadows for ESP-IDF
+*
+*   Textures are classified on upload: opaque (plain row copies), keyed (alpha 0 or 255 only,
+*   transparent pixels skipped) or blended
+*
+*   Textures uploaded while shadows are enabled (raylib_esp_set_texture_shadows()) keep an
+*   RGB565 (plus 8-bit alpha) copy, so the blit fast path (rlgl_esp_idf.c) can copy unscaled
+*   sprites row by row instead of sampling them through rlsw; GRAY_ALPHA font atlases keep
+*   their alpha plane only, so the glyph cache (rtext_esp_idf.c) can build masks from them
+*
+*   24/32-bit uploads are converted once to the matching 16-bit format (RGB565 when opaque,
+*   RGBA5551 for keyed, RGBA4444 for blended alpha) before they reach rlsw, halving texture
+*   memory and sampling bandwidth. Texture2D.format keeps the decoded format: later updates
+*   are converted the same way, and readbacks (LoadImageFromTexture()) are converted back
+*
+*   rlsw allocates texture storage in PSRAM. Small textures keep a copy of their uploaded
+*   pixels, textured draws are counted per frame, and every ESP_TEXTURE_RESIDENCY_INTERVAL
+*   frames the hottest ones that fit the internal RAM budget get their rlsw storage
+*   re-specified in internal RAM (the others move back to PSRAM)
+*
+**********************************************************************************************/
+
+#include "config.h"
+#include "raylib.h"
+#include "rlgl.h"
+#include "esp_idf_internal.h"
+#include "raylib_esp.h"
+#include <string.h>
+
+#include "esp_heap_caps.h"
+
+//----------------------------------------------------------------------------------
+// Real implementations (resolved by the linker, see rlgl_esp_idf.c)
+//----------------------------------------------------------------------------------
+unsigned int __real_rlLoadTexture(const void *data, int width, int height, int format, int mipmapCount);
+void __real_rlUpdateTexture(unsigned int id, int offsetX, int offsetY, int width, int height, int format, const void *data);
+void __real_rlUnloadTexture(unsigned int id);
+void *__real_rlReadTexturePixels(unsigned int id, int width, int height, int format);
+
+// rlsw texture storage (re-specified to move it between memories)
+extern void swBindTexture(uint32_t id);
+extern void swTexImage2D(int width, int height, unsigned int format, unsigned int type, const void *data);
+
+//----------------------------------------------------------------------------------
+// Types and Structures
+//----------------------------------------------------------------------------------
+// Texture stored by rlsw in a 16-bit format other than the one the application uploads
+typedef struct {
+    unsigned int id;
+    int native;                 // Format rlsw stores (Texture2D.format keeps the uploaded one)
+} NativeTexture;
+
+// Texture small enough for internal RAM, uploaded pixels kept in PSRAM to move rlsw storage
+typedef struct {
+    unsigned int id;
+    int width;
+    int height;
+    int format;                 // Format rlsw stores
+    void *pixels;
+    int bytes;
+    uint32_t uses;              // Textured draws this frame
+    uint32_t heat;              // Draws per frame, decayed by half each frame
+    bool internal;              // rlsw storage currently in internal RAM
+} ResidentTexture;
+
+typedef struct {
+    EspTextureShadow shadows[ESP_BLIT_MAX_TEXTURES];
+    int count;
+    NativeTexture natives[ESP_TEXTURE_MAX_NATIVE];
+    int nativeCount;
+    ResidentTexture residents[ESP_TEXTURE_MAX_RESIDENT];
+    int residentCount;
+    bool shadowUploads;         // raylib_esp_set_texture_shadows()
+    size_t budget;
+    uint32_t frames;
+    raylib_esp_texture_stats_t stats;
+} TextureData;
+
+//----------------------------------------------------------------------------------
+// Global Variables Definition
+//----------------------------------------------------------------------------------
+static TextureData textures = { .budget = ESP_TEXTURE_RESIDENCY_BUDGET };
+
+//----------------------------------------------------------------------------------
+// Module Internal Functions
+//----------------------------------------------------------------------------------
+
+static bool FormatSupported(int format)
+{
+    return (format >= PIXELFORMAT_UNCOMPRESSED_GRAYSCALE) && (format <= PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
+}
+
+static bool FormatHasAlpha(int format)
+{
+    return (format == PIXELFORMAT_UNCOMPRESSED_GRAY_ALPHA) || (format == PIXELFORMAT_UNCOMPRESSED_R5G5B5A1) ||
+           (format == PIXELFORMAT_UNCOMPRESSED_R4G4B4A4) || (format == PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
+}
+
+static uint16_t Pack565(int r, int g, int b)
+{
+    return (uint16_t)(((r >> 3) << 11) | ((g >> 2) << 5) | (b >> 3));
+}
+
+// Read pixel i of an uncompressed raylib format as 8-bit channels (5/6/4-bit channels bit-replicated)
+static void ReadPixel(const void *data, int format, int i, uint8_t *rgba)
+{
+    const uint8_t *src8 = data;
+    const uint16_t *src16 = data;
+    uint16_t p = 0;
+
+    switch (format) {
+        case PIXELFORMAT_UNCOMPRESSED_GRAYSCALE: rgba[0] = rgba[1] = rgba[2] = src8[i]; rgba[3] = 255; break;
+        case PIXELFORMAT_UNCOMPRESSED_GRAY_ALPHA: rgba[0] = rgba[1] = rgba[2] = src8[i*2]; rgba[3] = src8[i*2 + 1]; break;
+        case PIXELFORMAT_UNCOMPRESSED_R5G6B5: {
+            p = src16[i];
+            rgba[0] = (uint8_t)(((p >> 11) << 3) | (p >> 13));
+            rgba[1] = (uint8_t)((((p >> 5) & 0x3F) << 2) | ((p >> 9) & 0x3));
+            rgba[2] = (uint8_t)(((p & 0x1F) << 3) | ((p >> 2) & 0x7));
+            rgba[3] = 255;
+        } break;
+        case PIXELFORMAT_UNCOMPRESSED_R8G8B8: rgba[0] = src8[i*3]; rgba[1] = src8[i*3 + 1]; rgba[2] = src8[i*3 + 2]; rgba[3] = 255; break;
+        case PIXELFORMAT_UNCOMPRESSED_R5G5B5A1: {
+            p = src16[i];
+            rgba[0] = (uint8_t)(((p >> 11) << 3) | (p >> 13));
+            rgba[1] = (uint8_t)((((p >> 6) & 0x1F) << 3) | ((p >> 8) & 0x7));
+            rgba[2] = (uint8_t)((((p >> 1) & 0x1F) << 3) | ((p >> 3) & 0x7));
+            rgba[3] = (p & 1)? 255 : 0;
+        } break;
+        case PIXELFORMAT_UNCOMPRESSED_R4G4B4A4: {
+            p = src16[i];
+            rgba[0] = (uint8_t)((p >> 12)*17);
+            rgba[1] = (uint8_t)(((p >> 8) & 0xF)*17);
+            rgba[2] = (uint8_t)(((p >> 4) & 0xF)*17);
+            rgba[3] = (uint8_t)((p & 0xF)*17);
+        } break;
+        case PIXELFORMAT_UNCOMPRESSED_R8G8B8A8: memcpy(rgba, &src8[i*4], 4); break;
+        default: rgba[0] = rgba[1] = rgba[2] = rgba[3] = 255; break;
+    }
+}
+
+// Convert count pixels of an uncompressed raylib format to RGB565 and alpha (either may be NULL)
+static void ConvertPixels(uint16_t *rgb, uint8_t *alpha, const void *data, int format, int count)
+{
+    uint8_t rgba[4] = { 0 };
+
+    for (int i = 0; i < count; i++) {
+        ReadPixel(data, format, i, rgba);
+        if (rgb) rgb[i] = (format == PIXELFORMAT_UNCOMPRESSED_R5G6B5)? ((const uint16_t *)data)[i] : Pack565(rgba[0], rgba[1], rgba[2]);
+        if (alpha) alpha[i] = rgba[3];
+    }
+}
+
+// 16-bit format matching the framebuffer for 24/32-bit uploads: RGB565 when opaque,
+// RGBA5551 when alpha is only 0 or 255, RGBA4444 otherwise
+static int NativeFormat(const void *data, int format, int count)
+{
+    if (format == PIXELFORMAT_UNCOMPRESSED_R8G8B8) return PIXELFORMAT_UNCOMPRESSED_R5G6B5;
+    if (format != PIXELFORMAT_UNCOMPRESSED_R8G8B8A8) return format;
+
+    const uint8_t *src = data;
+    bool opaque = true;
+    for (int i = 0; i < count; i++) {
+        uint8_t a = src[i*4 + 3];
+        if ((a != 0) && (a != 255)) return PIXELFORMAT_UNCOMPRESSED_R4G4B4A4;
+        if (a == 0) opaque = false;
+    }
+
+    return opaque? PIXELFORMAT_UNCOMPRESSED_R5G6B5 : PIXELFORMAT_UNCOMPRESSED_R5G5B5A1;
+}
+
+static void ConvertNative(uint16_t *dst, const void *data, int format, int native, int count)
+{
+    uint8_t rgba[4] = { 0 };
+
+    for (int i = 0; i < count; i++) {
+        ReadPixel(data, format, i, rgba);
+
+        switch (native) {
+            case PIXELFORMAT_UNCOMPRESSED_R5G6B5: dst[i] = Pack565(rgba[0], rgba[1], rgba[2]); break;
+            case PIXELFORMAT_UNCOMPRESSED_R5G5B5A1: {
+                dst[i] = (uint16_t)(((rgba[0] >> 3) << 11) | ((rgba[1] >> 3) << 6) | ((rgba[2] >> 3) << 1) | (rgba[3] >> 7));
+            } break;
+            case PIXELFORMAT_UNCOMPRESSED_R4G4B4A4: {
+                dst[i] = (uint16_t)(((rgba[0] >> 4) << 12) | ((rgba[1] >> 4) << 8) | ((rgba[2] >> 4) << 4) | (rgba[3] >> 4));
+            } break;
+            default: break;
+        }
+    }
+}
+
+static NativeTexture *NativeFind(unsigned int id)
+{
+    for (int i = 0; i < textures.nativeCount; i++) {
+        if (textures.natives[i].id == id) return &textures.natives[i];
+    }
+    return NULL;
+}
+
+static EspTextureKind Classify(const EspTextureShadow *shadow)
+{
+    if (!shadow->alpha) return ESP_TEXTURE_OPAQUE;
+
+    bool opaque = true;
+    for (int i = 0; i < shadow->width*shadow->height; i++) {
+        uint8_t a = shadow->alpha[i];
+        if ((a != 0) && (a != 255)) return ESP_TEXTURE_BLENDED;
+        if (a == 0) opaque = false;
+    }
+
+    return opaque? ESP_TEXTURE_OPAQUE : ESP_TEXTURE_KEYED;
+}
+
+static void *TextureAlloc(size_t size)
+{
+    void *ptr = heap_caps_malloc(size, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+    if (!ptr) ptr = heap_caps_malloc(size, MALLOC_CAP_DEFAULT);
+    return ptr;
+}
+
+static void ShadowFree(EspTextureShadow *shadow)
+{
+    heap_caps_free(shadow->pixels);
+    heap_caps_free(shadow->alpha);
+    *shadow = (EspTextureShadow){ 0 };
+}
+
+static void ShadowCreate(unsigned int id, const void *data, int width, int height, int format)
+{
+    if ((id == 0) || !data || !FormatSupported(format) || (width*height > ESP_BLIT_MAX_TEXTURE_PIXELS)) return;
+    if (textures.count == ESP_BLIT_MAX_TEXTURES) return;
+
+    // Colors only when the application opted in, alpha is needed to classify
+    bool keepPixels = SUPPORT_ESP_FAST_BLIT && textures.shadowUploads;
+
+    EspTextureShadow shadow = { .id = id, .width = width, .height = height };
+    if (keepPixels) shadow.pixels = TextureAlloc(width*height*sizeof(uint16_t));
+    if (FormatHasAlpha(format)) shadow.alpha = TextureAlloc(width*height);
+
+    if ((keepPixels && !shadow.pixels) || (FormatHasAlpha(format) && !shadow.alpha)) {
+        ShadowFree(&shadow);
+        return;
+    }
+
+    ConvertPixels(shadow.pixels, shadow.alpha, data, format, width*height);
+    shadow.kind = Classify(&shadow);
+
+    // Opaque textures need no alpha plane, others keep it for blits or glyph masks only
+    bool keepAlpha = (shadow.kind != ESP_TEXTURE_OPAQUE) &&
+                     (keepPixels || (SUPPORT_ESP_GLYPH_CACHE && (format == PIXELFORMAT_UNCOMPRESSED_GRAY_ALPHA)));
+    if (!keepAlpha && shadow.alpha) {
+        heap_caps_free(shadow.alpha);
+        shadow.alpha = NULL;
+    }
+
+    textures.shadows[textures.count++] = shadow;
+}
+
+static EspTextureShadow *ShadowFind(unsigned int id)
+{
+    for (int i = 0; i < textures.count; i++) {
+        if (textures.shadows[i].id == id) return &textures.shadows[i];
+    }
+    return NULL;
+}
+
+static void ShadowRemove(unsigned int id)
+{
+    EspTextureShadow *shadow = ShadowFind(id);
+    if (!shadow) return;
+
+    ShadowFree(shadow);
+    *shadow = textures.shadows[--textures.count];
+}
+
+static ResidentTexture *ResidentFind(unsigned int id)
+{
+    for (int i = 0; i < textures.residentCount; i++) {
+        if (textures.residents[i].id == id) return &textures.residents[i];
+    }
+    return NULL;
+}
+
+// Keep a copy of small uploads so their rlsw storage can be re-specified later
+static void ResidentCreate(unsigned int id, const void *data, int width, int height, int format, int mipmapCount)
+{
+#if SUPPORT_ESP_TEXTURE_RESIDENCY
+    if ((id == 0) || !data || (mipmapCount != 1) || (textures.residentCount == ESP_TEXTURE_MAX_RESIDENT)) return;
+
+    int bytes = GetPixelDataSize(width, height, format);
+    if ((bytes <= 0) || ((size_t)bytes > textures.budget)) return;
+
+    void *pixels = TextureAlloc(bytes);
+    if (!pixels) return;
+    memcpy(pixels, data, bytes);
+
+    textures.residents[textures.residentCount++] = (ResidentTexture){
+        .id = id, .width = width, .height = height, .format = format, .pixels = pixels, .bytes = bytes
+    };
+#endif
+}
+
+static void ResidentRemove(unsigned int id)
+{
+    ResidentTexture *res = ResidentFind(id);
+    if (!res) return;
+
+    if (res->internal) {
+        textures.stats.resident--;
+        textures.stats.resident_bytes -= res->bytes;
+    }
+    heap_caps_free(res->pixels);
+    *res = textures.residents[--textures.residentCount];
+}
+
+// Re-specify the rlsw texture storage from the kept pixels, in internal RAM or PSRAM
+static void ResidentMove(ResidentTexture *res, bool internal)
+{
+    unsigned int glInternalFormat = 0, glFormat = 0, glType = 0;
+    rlGetGlTextureFormats(res->format, &glInternalFormat, &glFormat, &glType);
+
+    EspSwMallocInternal(internal);
+    swBindTexture(res->id);
+    swTexImage2D(res->width, res->height, glFormat, glType, res->pixels);
+    swBindTexture(0);
+    EspSwMallocInternal(false);
+
+    res->internal = internal;
+    if (internal) {
+        textures.stats.promotions++;
+        textures.stats.resident++;
+        textures.stats.resident_bytes += res->bytes;
+    } else {
+        textures.stats.demotions++;
+        textures.stats.resident--;
+        textures.stats.resident_bytes -= res->bytes;
+    }
+}
+
+// Hottest textures that fit the budget go to internal RAM, the rest back to PSRAM
+static void ResidentRebalance(void)
+{
+    int order[ESP_TEXTURE_MAX_RESIDENT] = { 0 };
+    bool chosen[ESP_TEXTURE_MAX_RESIDENT] = { 0 };
+
+    for (int i = 0; i < textures.residentCount; i++) {
+        int j = i;
+        while ((j > 0) && (textures.residents[order[j - 1]].heat < textures.residents[i].heat)) {
+            order[j] = order[j - 1];
+            j--;
+        }
+        order[j] = i;
+    }
+
+    size_t used = 0;
+    for (int i = 0; i < textures.residentCount; i++) {
+        ResidentTexture *res = &textures.residents[order[i]];
+        if ((res->heat == 0) || (used + res->bytes > textures.budget)) continue;
+
+        chosen[order[i]] = true;
+        used += res->bytes;
+    }
+
+    // Demote first so promotions can reuse the memory
+    for (int i = 0; i < textures.residentCount; i++) {
+        if (textures.residents[i].internal && !chosen[i]) ResidentMove(&textures.residents[i], false);
+    }
+
+    for (int i = 0; i < textures.residentCount; i++) {
+        ResidentTexture *res = &textures.residents[i];
+        if (!chosen[i] || res->internal) continue;
+
+        size_t largest = heap_caps_get_largest_free_block(MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+        if (largest < (size_t)res->bytes + ESP_TEXTURE_RESIDENCY_RESERVE) continue;
+
+        ResidentMove(res, true);
+    }
+}
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition
+//----------------------------------------------------------------------------------
+
+const EspTextureShadow *EspTextureFind(unsigned int id)
+{
+    return ShadowFind(id);
+}
+
+void EspTextureClose(void)
+{
+    for (int i = 0; i < textures.count; i++) ShadowFree(&textures.shadows[i]);
+    textures.count = 0;
+
+    for (int i = 0; i < textures.residentCount; i++) heap_caps_free(textures.residents[i].pixels);
+    textures.residentCount = 0;
+    textures.frames = 0;
+    textures.stats = (raylib_esp_texture_stats_t){ 0 };
+}
+
+void EspTextureUse(unsigned int id)
+{
+#if SUPPORT_ESP_TEXTURE_RESIDENCY
+    ResidentTexture *res = ResidentFind(id);
+    if (!res) return;
+
+    res->uses++;
+    if (res->internal) textures.stats.hits++;
+    else textures.stats.misses++;
+#endif
+}
+
+void EspTextureFrame(void)
+{
+#if SUPPORT_ESP_TEXTURE_RESIDENCY
+    for (int i = 0; i < textures.residentCount; i++) {
+        ResidentTexture *res = &textures.residents[i];
+        res->heat = res->heat/2 + res->uses;
+        res->uses = 0;
+    }
+
+    if (++textures.frames % ESP_TEXTURE_RESIDENCY_INTERVAL == 0) ResidentRebalance();
+#endif
+}
+
+//----------------------------------------------------------------------------------
+// Public API
+//----------------------------------------------------------------------------------
+
+void raylib_esp_set_texture_budget(size_t bytes)
+{
+    textures.budget = bytes;
+
+#if SUPPORT_ESP_TEXTURE_RESIDENCY
+    ResidentRebalance();
+#endif
+}
+
+void raylib_esp_get_texture_stats(raylib_esp_texture_stats_t *stats)
+{
+    if (!stats) return;
+
+    *stats = textures.stats;
+}
+
+void raylib_esp_set_texture_shadows(bool enable)
+{
+    textures.shadowUploads = enable;
+}
+
+//----------------------------------------------------------------------------------
+// rlgl: texture management (interposed)
+//----------------------------------------------------------------------------------
+
+unsigned int __wrap_rlLoadTexture(const void *data, int width, int height, int format, int mipmapCount)
+{
+    const void *upload = data;
+    int uploadFormat = format;
+    uint16_t *converted = NULL;
+
+#if SUPPORT_ESP_NATIVE_TEXTURES
+    // Mipmap chains and render targets (no data) are uploaded as they are
+    int native = (data && (mipmapCount == 1))? NativeFormat(data, format, width*height) : format;
+    if ((native != format) && (textures.nativeCount < ESP_TEXTURE_MAX_NATIVE)) {
+        converted = TextureAlloc(width*height*sizeof(uint16_t));
+        if (converted) {
+            ConvertNative(converted, data, format, native, width*height);
+            upload = converted;
+            uploadFormat = native;
+        }
+    }
+#endif
+
+    unsigned int id = __real_rlLoadTexture(upload, width, height, uploadFormat, mipmapCount);
+
+    if ((id != 0) && (uploadFormat != format)) textures.natives[textures.nativeCount++] = (NativeTexture){ id, uploadFormat };
+
+#if SUPPORT_ESP_FAST_BLIT || SUPPORT_ESP_GLYPH_CACHE
+    ShadowCreate(id, upload, width, height, uploadFormat);
+#endif
+    ResidentCreate(id, upload, width, height, uploadFormat, mipmapCount);
+
+    heap_caps_free(converted);
+    return id;
+}
+
+void __wrap_rlUpdateTexture(unsigned int id, int offsetX, int offsetY, int width, int height, int format, const void *data)
+{
+    const void *upload = data;
+    int uploadFormat = format;
+    uint16_t *converted = NULL;
+
+    // Updates arrive in Texture2D.format, convert them to the stored format
+    NativeTexture *native = NativeFind(id);
+    if (native && data && (format != native->native)) {
+        converted = TextureAlloc(width*height*sizeof(uint16_t));
+        if (!converted) {
+            TRACELOG(LOG_WARNING, "TEXTURE: [ID %i] Failed to allocate conversion buffer for update", id);
+            return;
+        }
+        ConvertNative(converted, data, format, native->native, width*height);
+        upload = converted;
+        uploadFormat = native->native;
+    }
+
+    __real_rlUpdateTexture(id, offsetX, offsetY, width, height, uploadFormat, upload);
+
+    // Keep the resident copy in sync, or stop tracking the texture
+    ResidentTexture *res = ResidentFind(id);
+    if (res) {
+        int pixelBytes = GetPixelDataSize(1, 1, uploadFormat);
+        if (!upload || (uploadFormat != res->format) || (offsetX < 0) || (offsetY < 0) ||
+            (offsetX + width > res->width) || (offsetY + height > res->height)) {
+            ResidentRemove(id);
+        } else {
+            for (int y = 0; y < height; y++) {
+                memcpy((uint8_t *)res->pixels + ((offsetY + y)*res->width + offsetX)*pixelBytes,
+                       (const uint8_t *)upload + y*width*pixelBytes, width*pixelBytes);
+            }
+        }
+    }
+
+    EspTextureShadow *shadow = ShadowFind(id);
+    if (shadow) {
+        // Cached glyphs may come from this texture
+        EspGlyphCacheClear();
+
+        // Alpha appearing in an opaque texture, or a region out of range: stop shadowing it
+        if (!FormatSupported(uploadFormat) || (FormatHasAlpha(uploadFormat) && !shadow->alpha) || (offsetX < 0) || (offsetY < 0) ||
+            (offsetX + width > shadow->width) || (offsetY + height > shadow->height)) {
+            ShadowRemove(id);
+        } else {
+            int pixelBytes = GetPixelDataSize(1, 1, uploadFormat);
+            for (int y = 0; y < height; y++) {
+                int index = (offsetY + y)*shadow->width + offsetX;
+                ConvertPixels(shadow->pixels? shadow->pixels + index : NULL, shadow->alpha? shadow->alpha + index : NULL,
+                              (const uint8_t *)upload + (y*width*pixelBytes), uploadFormat, width);
+            }
+
+            shadow->kind = Classify(shadow);
+        }
+    }
+
+    heap_caps_free(converted);
+}
+
+// Texture2D.format is the uploaded format: read the stored one and convert it back
+void *__wrap_rlReadTexturePixels(unsigned int id, int width, int height, int format)
+{
+    NativeTexture *native = NativeFind(id);
+    if (!native || (native->native == format)) return __real_rlReadTexturePixels(id, width, height, format);
+
+    Image image = { __real_rlReadTexturePixels(id, width, height, native->native), width, height, 1, native->native };
+    if (!image.data) return NULL;
+
+    ImageFormat(&image, format);
+    return image.data;
+}
+
+void __wrap_rlUnloadTexture(unsigned int id)
+{
+    // The id may be reused by a later upload
+    if (ShadowFind(id)) EspGlyphCacheClear();
+    ShadowRemove(id);
+
+    NativeTexture *native = NativeFind(id);
+    if (native) *native = textures.natives[--textures.nativeCount];
+
+    ResidentRemove(id);
+    __real_rlUnloadTexture(id);
+}
@@ -0,0 +1,177 @@
+/**********************************************************************************************
+*
+*   rtrace_esp_idf - Render and present trace events for ESP-IDF
+*
+*   Frame phases (rprofile_esp_idf.c) and the trace points of esp_idf_internal.h become timeline
+*   events. With SEGGER SystemView enabled in app_trace (CONFIG_APPTRACE_SV_ENABLE) they are
+*   sent as user start/stop events with the event number as id; otherwise, between
+*   raylib_esp_trace_start() and raylib_esp_trace_stop(), they are written as Chrome trace_event
+*   JSON (complete events, one track per core) that Perfetto or chrome://tracing open directly
+*
+*   With SUPPORT_ESP_TRACE 0 the trace points expand to nothing
+*
+**********************************************************************************************/
+
+#include "config.h"
+#include "raylib.h"
+#include "esp_idf_internal.h"
+#include "raylib_esp.h"
+#include <stdio.h>
+
+#if SUPPORT_ESP_TRACE
+#if defined(ESP_PLATFORM)
+    #include "esp_cpu.h"
+    #include "esp_timer.h"
+    #include "soc/soc_caps.h"
+    #include "sdkconfig.h"
+    #if CONFIG_APPTRACE_SV_ENABLE
+        #include "SEGGER_SYSVIEW.h"
+    #endif
+#else
+    #include <time.h>
+    #define SOC_CPU_CORES_NUM 1
+#endif
+
+_Static_assert((int)RAYLIB_ESP_PHASE_COUNT <= (int)ESP_TRACE_SWAP, "Trace event ids overlap frame phases");
+
+//----------------------------------------------------------------------------------
+// Types and Structures
+//----------------------------------------------------------------------------------
+typedef struct {
+    FILE *out;                              // Chrome trace output, NULL when not tracing
+    int64_t start[ESP_TRACE_EVENT_COUNT];   // Begin timestamp per event (us)
+    int64_t origin;                         // Timestamp at raylib_esp_trace_start()
+} TraceData;
+
+//----------------------------------------------------------------------------------
+// Global Variables Definition
+//----------------------------------------------------------------------------------
+static TraceData trace = { 0 };
+
+static const char *EVENT_NAMES[ESP_TRACE_EVENT_COUNT] = {
+    [RAYLIB_ESP_PHASE_DRAW] = "draw",
+    [RAYLIB_ESP_PHASE_REPLAY] = "replay",
+    [RAYLIB_ESP_PHASE_COPY] = "copy",
+    [RAYLIB_ESP_PHASE_FLUSH] = "flush",
+    [RAYLIB_ESP_PHASE_PACE] = "pace",
+    [RAYLIB_ESP_PHASE_FRAME] = "frame",
+    [ESP_TRACE_SWAP] = "SwapScreenBuffer",
+    [ESP_TRACE_FLUSH_CALLBACK] = "flush callback",
+    [ESP_TRACE_POLL_INPUT] = "PollInputEvents",
+};
+
+//----------------------------------------------------------------------------------
+// Module Internal Functions
+//----------------------------------------------------------------------------------
+
+static int64_t TraceTime(void)
+{
+#if defined(ESP_PLATFORM)
+    return esp_timer_get_time();
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec*1000000 + ts.tv_nsec/1000;
+#endif
+}
+
+static int TraceCore(void)
+{
+#if defined(ESP_PLATFORM)
+    return esp_cpu_get_core_id();
+#else
+    return 0;
+#endif
+}
+
+// One complete event (instant event for a negative duration) per call: stdio locks the stream
+// for each fprintf(), so events from the render and present tasks never interleave
+static void TraceWrite(int event, int64_t start, int64_t duration)
+{
+    FILE *out = trace.out;
+    if (!out) return;
+
+    if (duration < 0) {
+        fprintf(out, "{\"name\":\"%s\",\"ph\":\"i\",\"s\":\"t\",\"ts\":%lld,\"pid\":0,\"tid\":%d},\n",
+                EVENT_NAMES[event], (long long)(start - trace.origin), TraceCore());
+    }
+    else {
+        fprintf(out, "{\"name\":\"%s\",\"ph\":\"X\",\"ts\":%lld,\"dur\":%lld,\"pid\":0,\"tid\":%d},\n",
+                EVENT_NAMES[event], (long long)(start - trace.origin), (long long)duration, TraceCore());
+    }
+}
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition
+//----------------------------------------------------------------------------------
+
+void EspTraceBegin(int event)
+{
+#if defined(ESP_PLATFORM) && CONFIG_APPTRACE_SV_ENABLE
+    SEGGER_SYSVIEW_OnUserStart((unsigned)event);
+#else
+    if (trace.out) trace.start[event] = TraceTime();
+#endif
+}
+
+void EspTraceEnd(int event)
+{
+#if defined(ESP_PLATFORM) && CONFIG_APPTRACE_SV_ENABLE
+    SEGGER_SYSVIEW_OnUserStop((unsigned)event);
+#else
+    // Skip phases that began before raylib_esp_trace_start()
+    int64_t start = trace.start[event];
+    if (trace.out && (start >= trace.origin)) TraceWrite(event, start, TraceTime() - start);
+#endif
+}
+
+void EspTraceMark(int event)
+{
+#if defined(ESP_PLATFORM) && CONFIG_APPTRACE_SV_ENABLE
+    SEGGER_SYSVIEW_OnUserStart((unsigned)event);
+    SEGGER_SYSVIEW_OnUserStop((unsigned)event);
+#else
+    if (trace.out) TraceWrite(event, TraceTime(), -1);
+#endif
+}
+#endif // SUPPORT_ESP_TRACE
+
+//----------------------------------------------------------------------------------
+// Public API
+//----------------------------------------------------------------------------------
+
+bool raylib_esp_trace_start(FILE *out)
+{
+#if SUPPORT_ESP_TRACE && !(defined(ESP_PLATFORM) && CONFIG_APPTRACE_SV_ENABLE)
+    if (!out || trace.out) return false;
+
+    fprintf(out, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+    for (int core = 0; core < SOC_CPU_CORES_NUM; core++) {
+        fprintf(out, "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":%d,\"args\":{\"name\":\"core %d\"}},\n", core, core);
+    }
+
+    trace.origin = TraceTime();
+    trace.out = out;
+
+    return true;
+#else
+    (void)out;
+    return false;
+#endif
+}
+
+void raylib_esp_trace_stop(void)
+{
+#if SUPPORT_ESP_TRACE && !(defined(ESP_PLATFORM) && CONFIG_APPTRACE_SV_ENABLE)
+    FILE *out = trace.out;
+    if (!out) return;
+
+    // Let the present task finish its flushes before the array is closed
+    raylib_esp_wait_present();
+    trace.out = NULL;
+
+    // Every event ends with a comma, a final metadata event closes the array
+    fprintf(out, "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":0,\"args\":{\"name\":\"raylib\"}}\n]}\n");
+    fflush(out);
+#endif
+}
@@ -5,7 +5,8 @@
  * Architecture:
  * - BSP handles display hardware (for boards with BSP components)
  * - Direct esp_lcd init for boards without BSP (e.g., esp32_s3_box)
- * - rcore callback interface connects raylib to display
+ * - raylib owns the present path: flip, byte swap and pooled DMA chunk transfers
+ *   run inside the component (raylib_esp_set_panel)
  * - No separate port layer needed
  *
  * Board configurations sourced from esp-bsp JSON files:
@@ -24,6 +25,7 @@
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
 #include "raylib.h"
+#include "raylib_esp.h"
 //ELIF option("m5stack_atom_s3r")
 #include "esp_log.h"
 #include "esp_err.h"
@@ -36,6 +38,7 @@
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
 #include "raylib.h"
+#include "raylib_esp.h"
 //ELSE
 #include "bsp/esp-bsp.h"
 #include "esp_log.h"
@@ -44,6 +47,7 @@
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
 #include "raylib.h"
+#include "raylib_esp.h"
 //ENDIF
 
 //IF option("esp32_s3_box_3")
@@ -72,48 +76,6 @@ static const char *TAG = "M5STACK_CORES3";
 static esp_lcd_panel_handle_t g_panel = NULL;
 static esp_lcd_panel_io_handle_t g_io = NULL;
 
-// Chunk size: 48 lines (matches BSP max_transfer_sz)
-#define CHUNK_LINES 48
-
-/**
- * @brief Display flush callback for rcore - chunks framebuffer
- */
-static void display_flush(const uint16_t *buf, uint16_t x, uint16_t y, uint16_t w, uint16_t h)
-{
-    if (!g_panel || !buf) {
-        return;
-    }
-
-    // Flush in chunks (48 lines max) to match BSP max_transfer_sz
-    for (uint16_t row = 0; row < h; row += CHUNK_LINES) {
-        uint16_t chunk_height = (row + CHUNK_LINES > h) ? (h - row) : CHUNK_LINES;
-        const uint16_t *chunk_pixels = buf + (row * w);
-
-        // Swap bytes for RGB565 (little-endian ESP32 to big-endian SPI LCD)
-        // Allocate temporary buffer for swapped bytes
-        uint16_t *swapped_buf = heap_caps_malloc(chunk_height * w * sizeof(uint16_t), MALLOC_CAP_DMA);
-        if (!swapped_buf) {
-            ESP_LOGE(TAG, "Failed to allocate swap buffer");
-            return;
-        }
-        for (int i = 0; i < chunk_height * w; i++) {
-            swapped_buf[i] = __builtin_bswap16(chunk_pixels[i]);
-        }
-
-        esp_err_t ret = esp_lcd_panel_draw_bitmap(
-            g_panel,
-            x, y + row, x + w, y + row + chunk_height,
-            swapped_buf
-        );
-        heap_caps_free(swapped_buf);
-
-        if (ret != ESP_OK) {
-            ESP_LOGE(TAG, "Failed to draw bitmap chunk at row %d: %s", row, esp_err_to_name(ret));
-            return;
-        }
-    }
-}
-
 /**
  * @brief Get display dimensions callback
  * Source: esp-bsp/bsp/<board>/<board>.json -> BSP_LCD_H_RES, BSP_LCD_V_RES
@@ -153,12 +115,6 @@ static void display_get_dimensions(uint16_t *w, uint16_t *h)
     //ENDIF
 }
 
-// External rcore callback
-extern void raylib_esp_set_display_callbacks(
-    void (*flush_fn)(const uint16_t *buf, uint16_t x, uint16_t y, uint16_t w, uint16_t h),
-    void (*get_dim_fn)(uint16_t *w, uint16_t *h)
-);
-
 #define RAYLIB_TASK_STACK_SIZE (128 * 1024)
 
 /**
@@ -168,6 +124,9 @@ static esp_err_t init_display(void)
 {
     ESP_LOGI(TAG, "Initializing display...");
 
+    // raylib present stage: ring of DMA bounce buffers sized to max_transfer_sz
+    raylib_esp_panel_config_t present_cfg = RAYLIB_ESP_PANEL_CONFIG_DEFAULT();
+
     //IF option("esp32_s3_box")
     // ESP32-S3-BOX has no BSP component - use direct esp_lcd init with hardcoded ST7789 pins
     // Pinout from esp-bsp/bsp/esp-box/
@@ -188,6 +147,7 @@ static esp_err_t init_display(void)
         .max_transfer_sz = 320 * 48 * sizeof(uint16_t),
     };
     ESP_ERROR_CHECK(spi_bus_initialize(SPI3_HOST, &bus_cfg, SPI_DMA_CH_AUTO));
+    present_cfg.max_transfer_sz = bus_cfg.max_transfer_sz;
 
     // LCD IO SPI configuration (ESP-IDF 6 API)
     esp_lcd_panel_io_spi_config_t io_cfg = {
@@ -205,6 +165,7 @@ static esp_err_t init_display(void)
 
     // Create panel IO (ESP-IDF 6 API - uses SPI3_HOST directly)
     ESP_ERROR_CHECK(esp_lcd_new_panel_io_spi(SPI3_HOST, &io_cfg, &g_io));
+    present_cfg.trans_queue_depth = io_cfg.trans_queue_depth;
 
     // ST7789 panel configuration (ESP-IDF 6 API)
     esp_lcd_panel_dev_config_t panel_cfg = {
@@ -251,6 +212,7 @@ static esp_err_t init_display(void)
         .max_transfer_sz = 128 * 128 * sizeof(uint16_t),
     };
     ESP_ERROR_CHECK(spi_bus_initialize(SPI3_HOST, &bus_cfg, SPI_DMA_CH_AUTO));
+    present_cfg.max_transfer_sz = bus_cfg.max_transfer_sz;
 
     // LCD IO SPI configuration (ESP-IDF 6 API)
     esp_lcd_panel_io_spi_config_t io_cfg = {
@@ -268,6 +230,7 @@ static esp_err_t init_display(void)
 
     // Create panel IO (ESP-IDF 6 API - uses SPI3_HOST directly)
     ESP_ERROR_CHECK(esp_lcd_new_panel_io_spi(SPI3_HOST, &io_cfg, &g_io));
+    present_cfg.trans_queue_depth = io_cfg.trans_queue_depth;
 
     // ST7789 panel configuration (ESP-IDF 6 API)
     esp_lcd_panel_dev_config_t panel_cfg = {
@@ -290,6 +253,8 @@ static esp_err_t init_display(void)
         .max_transfer_sz = 480 * 48 * sizeof(uint16_t),  // 48-line chunks
     };
     esp_err_t ret = bsp_display_new(&cfg, &g_panel, &g_io);
+    present_cfg.max_transfer_sz = cfg.max_transfer_sz;
+    present_cfg.rgb_frame_buffers = CONFIG_BSP_LCD_RGB_BUFFER_NUMS;  // Render straight into the panel frame buffers
     if (ret != ESP_OK) {
         ESP_LOGE(TAG, "BSP display init failed: %s", esp_err_to_name(ret));
         return ret;
@@ -301,6 +266,7 @@ static esp_err_t init_display(void)
         .max_transfer_sz = 128 * 128 * sizeof(uint16_t),  // Full frame
     };
     esp_err_t ret = bsp_display_new(&cfg, &g_panel, &g_io);
+    present_cfg.max_transfer_sz = cfg.max_transfer_sz;
     if (ret != ESP_OK) {
         ESP_LOGE(TAG, "BSP display init failed: %s", esp_err_to_name(ret));
         return ret;
@@ -312,6 +278,7 @@ static esp_err_t init_display(void)
         .max_transfer_sz = 320 * 48 * sizeof(uint16_t),  // 48-line chunks
     };
     esp_err_t ret = bsp_display_new(&cfg, &g_panel, &g_io);
+    present_cfg.max_transfer_sz = cfg.max_transfer_sz;
     if (ret != ESP_OK) {
         ESP_LOGE(TAG, "BSP display init failed: %s", esp_err_to_name(ret));
         return ret;
@@ -323,8 +290,14 @@ static esp_err_t init_display(void)
     // Small delay for display to stabilize
     vTaskDelay(pdMS_TO_TICKS(100));
 
-    // Register display callbacks with rcore
-    raylib_esp_set_display_callbacks(display_flush, display_get_dimensions);
+    // Hand the panel to raylib (the component registers on_color_trans_done on the IO)
+    //IF option("esp32_s3_lcd_ev_board")
+    // RGB panel: frames go into the panel frame buffers and swap on vsync, no IO callbacks
+    ESP_ERROR_CHECK(raylib_esp_set_panel(g_panel, NULL, &present_cfg));
+    //ELSE
+    ESP_ERROR_CHECK(raylib_esp_set_panel(g_panel, g_io, &present_cfg));
+    //ENDIF
+    raylib_esp_set_display_callbacks(NULL, display_get_dimensions);
 
     uint16_t w, h;
     display_get_dimensions(&w, &h);
@@ -381,7 +354,8 @@ void raylib_task(void *pvParameter)
     EndDrawing();
     vTaskDelay(pdMS_TO_TICKS(1000));
 
-    // Main loop
+    // Main loop, paced to 60 FPS (EndDrawing() sleeps out the rest of each frame)
+    SetTargetFPS(60);
     int frame = 0;
     while (!WindowShouldClose()) {
         BeginDrawing();
@@ -0,0 +1,212 @@
+/**********************************************************************************************
+*
+*   rpixel_checks - Scalar reference checks of the RGB565 pixel kernels (src/rpixel_esp_idf.c)
+*
+*   Every kernel is run over all source/destination alignments within a 16-byte line and
+*   every count up to a few blocks, and compared with a per-pixel scalar reference; bytes
+*   around the written span must stay untouched
+*
+*   Shared by the host test (test/host, portable paths) and the ESP32-S3 target test
+*   (test/target, PIE paths of rpixel_pie_esp_idf.S)
+*
+**********************************************************************************************/
+
+#include "rpixel_checks.h"
+#include "esp_idf_internal.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#define TEST_PIXELS 80
+#define TEST_PAD    8
+#define TEST_SIZE   (TEST_PIXELS + TEST_PAD)
+
+static uint16_t src[TEST_SIZE] __attribute__((aligned(16)));
+static uint16_t dst[TEST_SIZE] __attribute__((aligned(16)));
+static uint16_t ref[TEST_SIZE] __attribute__((aligned(16)));
+static uint8_t alpha[TEST_SIZE];
+
+static int failures = 0;
+
+//----------------------------------------------------------------------------------
+// Scalar references
+//----------------------------------------------------------------------------------
+
+static uint16_t Swap(uint16_t pixel)
+{
+    return (uint16_t)((pixel >> 8) | (pixel << 8));
+}
+
+// Channel by channel: dst + (src - dst)*alpha/32, truncated
+static uint16_t Blend(uint16_t s, uint16_t d, int alpha32)
+{
+    int sr = s >> 11, sg = (s >> 5) & 0x3F, sb = s & 0x1F;
+    int dr = d >> 11, dg = (d >> 5) & 0x3F, db = d & 0x1F;
+
+    int r = dr + (((sr - dr)*alpha32) >> 5);
+    int g = dg + (((sg - dg)*alpha32) >> 5);
+    int b = db + (((sb - db)*alpha32) >> 5);
+
+    return (uint16_t)((r << 11) | (g << 5) | b);
+}
+
+//----------------------------------------------------------------------------------
+// Test helpers
+//----------------------------------------------------------------------------------
+
+static void Reset(void)
+{
+    for (int i = 0; i < TEST_SIZE; i++) {
+        src[i] = (uint16_t)(i*0x9E37u + 0x1234u);
+        dst[i] = ref[i] = (uint16_t)(i*0x3B1Du + 0x0F0Fu);
+        alpha[i] = (uint8_t)(((i % 5) == 0)? 0 : ((i % 3) == 0)? 255 : i*37);
+    }
+}
+
+static void Check(const char *kernel, int srcOffset, int dstOffset, int count)
+{
+    if (memcmp(dst, ref, sizeof(dst)) == 0) return;
+
+    int first = 0;
+    while (dst[first] == ref[first]) first++;
+
+    printf("FAIL %s src+%d dst+%d count %d: pixel %d is %04x, expected %04x\n",
+           kernel, srcOffset, dstOffset, count, first, dst[first], ref[first]);
+    failures++;
+}
+
+//----------------------------------------------------------------------------------
+// Tests
+//----------------------------------------------------------------------------------
+
+static void TestCopies(void)
+{
+    for (int so = 0; so < TEST_PAD; so++) {
+        for (int dof = 0; dof < TEST_PAD; dof++) {
+            for (int count = 0; count <= TEST_PIXELS; count++) {
+                Reset();
+                EspPixelCopy(dst + dof, src + so, count);
+                for (int i = 0; i < count; i++) ref[dof + i] = src[so + i];
+                Check("EspPixelCopy", so, dof, count);
+
+                Reset();
+                EspPixelSwapCopy(dst + dof, src + so, count);
+                for (int i = 0; i < count; i++) ref[dof + i] = Swap(src[so + i]);
+                Check("EspPixelSwapCopy", so, dof, count);
+
+                Reset();
+                EspPixelCopyIsr(dst + dof, src + so, count);
+                for (int i = 0; i < count; i++) ref[dof + i] = src[so + i];
+                Check("EspPixelCopyIsr", so, dof, count);
+
+                Reset();
+                EspPixelSwapCopyIsr(dst + dof, src + so, count);
+                for (int i = 0; i < count; i++) ref[dof + i] = Swap(src[so + i]);
+                Check("EspPixelSwapCopyIsr", so, dof, count);
+            }
+        }
+    }
+}
+
+// 4 rows of 20 pixels read bottom-up (negative row step)
+static void TestCopyRows(void)
+{
+    for (int swap = 0; swap < 2; swap++) {
+        Reset();
+        EspPixelCopyRows(dst, 20, src + 60, -20, 20, 4, swap);
+        for (int row = 0; row < 4; row++) {
+            for (int i = 0; i < 20; i++) {
+                uint16_t pixel = src[60 - (row*20) + i];
+                ref[(row*20) + i] = swap? Swap(pixel) : pixel;
+            }
+        }
+        Check(swap? "EspPixelCopyRows (swap)" : "EspPixelCopyRows", 60, 0, 80);
+    }
+}
+
+static void TestSpans(void)
+{
+    const int alphas[] = { 0, 1, 64, 128, 200, 255 };
+
+    for (int dof = 0; dof < TEST_PAD; dof++) {
+        for (int count = 0; count <= TEST_PIXELS; count++) {
+            Reset();
+            EspPixelFill(dst + dof, 0xA55Au, count);
+            for (int i = 0; i < count; i++) ref[dof + i] = 0xA55Au;
+            Check("EspPixelFill", 0, dof, count);
+
+            for (int k = 0; k < (int)(sizeof(alphas)/sizeof(alphas[0])); k++) {
+                int a = alphas[k];
+
+                Reset();
+                EspPixelBlend(dst + dof, 0xF81Fu, a, count);
+                for (int i = 0; i < count; i++) ref[dof + i] = Blend(0xF81Fu, ref[dof + i], (a + 4) >> 3);
+                Check("EspPixelBlend", 0, dof, count);
+
+                // Coverage mask from the alpha pattern, fully covered runs are filled
+                Reset();
+                EspPixelMask(dst + dof, alpha, 0x07E0u, a, count);
+                for (int i = 0; i < count; i++) {
+                    if (alpha[i] == 0) continue;
+                    if ((alpha[i] == 255) && (a == 255)) ref[dof + i] = 0x07E0u;
+                    else ref[dof + i] = Blend(0x07E0u, ref[dof + i], (((alpha[i]*(a + 1)) >> 8) + 4) >> 3);
+                }
+                Check("EspPixelMask", 0, dof, count);
+            }
+        }
+    }
+}
+
+static void TestBlits(void)
+{
+    const uint32_t tints[] = { 0xFFFFFFFFu, 0xFFFFFF80u, 0x80C0FFFFu };
+
+    for (int so = 0; so < TEST_PAD; so++) {
+        for (int dof = 0; dof < TEST_PAD; dof++) {
+            for (int count = 0; count <= TEST_PIXELS; count++) {
+                Reset();
+                EspPixelBlitKeyed(dst + dof, src + so, alpha + so, count);
+                for (int i = 0; i < count; i++) {
+                    if (alpha[so + i] != 0) ref[dof + i] = src[so + i];
+                }
+                Check("EspPixelBlitKeyed", so, dof, count);
+
+                for (int k = 0; k < (int)(sizeof(tints)/sizeof(tints[0])); k++) {
+                    uint32_t tint = tints[k];
+                    int tr = (int)(tint >> 24) + 1, tg = (int)((tint >> 16) & 0xFF) + 1;
+                    int tb = (int)((tint >> 8) & 0xFF) + 1, ta = (int)(tint & 0xFF) + 1;
+
+                    Reset();
+                    EspPixelBlitBlend(dst + dof, src + so, alpha + so, tint, count);
+                    for (int i = 0; i < count; i++) {
+                        int a = (alpha[so + i]*ta) >> 8;
+                        if (a == 0) continue;
+
+                        uint16_t s = src[so + i];
+                        int r = ((s >> 11)*tr) >> 8, g = (((s >> 5) & 0x3F)*tg) >> 8, b = ((s & 0x1F)*tb) >> 8;
+                        uint16_t c = (tint == 0xFFFFFFFFu)? s : (uint16_t)((r << 11) | (g << 5) | b);
+                        ref[dof + i] = (a == 255)? c : Blend(c, ref[dof + i], (a + 4) >> 3);
+                    }
+                    Check("EspPixelBlitBlend", so, dof, count);
+                }
+            }
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition
+//----------------------------------------------------------------------------------
+
+// Run every check, returns the number of failures (each one printed)
+int RpixelChecksRun(void)
+{
+    failures = 0;
+
+    TestCopies();
+    TestCopyRows();
+    TestSpans();
+    TestBlits();
+
+    return failures;
+}
@@ -0,0 +1,12 @@
+/**********************************************************************************************
+*
+*   rpixel_checks - Scalar reference checks of the RGB565 pixel kernels (see rpixel_checks.c)
+*
+**********************************************************************************************/
+
+#ifndef RPIXEL_CHECKS_H
+#define RPIXEL_CHECKS_H
+
+int RpixelChecksRun(void);
+
+#endif // RPIXEL_CHECKS_H
@@ -0,0 +1,8 @@
+// config.h allocator macros only, the pixel kernels do not allocate
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define MALLOC_CAP_SPIRAM   (1 << 10)
+#define MALLOC_CAP_8BIT     (1 << 2)
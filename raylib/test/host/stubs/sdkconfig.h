@@ -0,0 +1,2 @@
+// Host build: no CONFIG_IDF_TARGET_*, the pixel kernels take their portable paths
+#pragma once
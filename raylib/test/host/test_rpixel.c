@@ -0,0 +1,22 @@
+/**********************************************************************************************
+*
+*   test_rpixel - Host checks of the portable RGB565 pixel kernels (src/rpixel_esp_idf.c)
+*
+*   No CONFIG_IDF_TARGET_* on the host, so every kernel takes its portable path; the PIE
+*   paths are checked on an ESP32-S3 by test/target
+*
+**********************************************************************************************/
+
+#include "rpixel_checks.h"
+
+#include <stdio.h>
+
+int main(void)
+{
+    int failures = RpixelChecksRun();
+
+    if (failures > 0) printf("%d pixel kernel checks failed\n", failures);
+    else printf("All pixel kernel checks passed\n");
+
+    return (failures > 0)? 1 : 0;
+}
@@ -0,0 +1,99 @@
+/**********************************************************************************************
+*
+*   test_rpixel_target - ESP32-S3 checks of the PIE pixel kernels (src/rpixel_pie_esp_idf.S)
+*
+*   The dispatching kernels are built with SUPPORT_ESP_PIE_KERNELS=1 and run through the
+*   same alignment, count and guard checks as test/host, so every 16-byte aligned case goes
+*   through the PIE blocks. The assembly functions are also called directly on aligned
+*   buffers, with guard pixels on both sides of the written blocks
+*
+**********************************************************************************************/
+
+#include "rpixel_checks.h"
+#include "config.h"
+#include "esp_idf_internal.h"
+#include <string.h>
+
+#include "sdkconfig.h"
+#include "unity.h"
+
+#if !CONFIG_IDF_TARGET_ESP32S3 || !SUPPORT_ESP_PIE_KERNELS
+    #error "test/target checks the PIE kernels: build for esp32s3 with SUPPORT_ESP_PIE_KERNELS=1"
+#endif
+
+#define PIE_MAX_BLOCKS  6
+#define PIE_GUARD       16      // Guard pixels on each side, keeps the blocks 16-byte aligned
+#define PIE_SIZE        (PIE_GUARD + PIE_MAX_BLOCKS*16 + PIE_GUARD)
+
+static uint16_t src[PIE_SIZE] __attribute__((aligned(16)));
+static uint16_t dst[PIE_SIZE] __attribute__((aligned(16)));
+static uint16_t ref[PIE_SIZE] __attribute__((aligned(16)));
+
+//----------------------------------------------------------------------------------
+// Test helpers
+//----------------------------------------------------------------------------------
+
+static void Reset(void)
+{
+    for (int i = 0; i < PIE_SIZE; i++) {
+        src[i] = (uint16_t)(i*0x9E37u + 0x1234u);
+        dst[i] = ref[i] = (uint16_t)(i*0x3B1Du + 0x0F0Fu);
+    }
+}
+
+//----------------------------------------------------------------------------------
+// Tests
+//----------------------------------------------------------------------------------
+
+static void TestPixelChecks(void)
+{
+    TEST_ASSERT_EQUAL_INT_MESSAGE(0, RpixelChecksRun(), "pixel kernel checks failed, see the log");
+}
+
+// 8 pixels per block
+static void TestCopyPie(void)
+{
+    for (int blocks = 0; blocks <= PIE_MAX_BLOCKS; blocks++) {
+        Reset();
+        EspPixelCopyPie(dst + PIE_GUARD, src + PIE_GUARD, blocks);
+        for (int i = 0; i < blocks*8; i++) ref[PIE_GUARD + i] = src[PIE_GUARD + i];
+        TEST_ASSERT_EQUAL_HEX16_ARRAY(ref, dst, PIE_SIZE);
+    }
+}
+
+// 16 pixels per block, bytes of each pixel swapped
+static void TestSwapCopyPie(void)
+{
+    for (int blocks = 0; blocks <= PIE_MAX_BLOCKS; blocks++) {
+        Reset();
+        EspPixelSwapCopyPie(dst + PIE_GUARD, src + PIE_GUARD, blocks);
+        for (int i = 0; i < blocks*16; i++) {
+            uint16_t pixel = src[PIE_GUARD + i];
+            ref[PIE_GUARD + i] = (uint16_t)((pixel >> 8) | (pixel << 8));
+        }
+        TEST_ASSERT_EQUAL_HEX16_ARRAY(ref, dst, PIE_SIZE);
+    }
+}
+
+// 8 pixels per block, color broadcast from an address that is not 16-byte aligned
+static void TestFillPie(void)
+{
+    uint16_t colors[2] = { 0x1234u, 0xA55Au };
+
+    for (int blocks = 0; blocks <= PIE_MAX_BLOCKS; blocks++) {
+        Reset();
+        EspPixelFillPie(dst + PIE_GUARD, &colors[1], blocks);
+        for (int i = 0; i < blocks*8; i++) ref[PIE_GUARD + i] = colors[1];
+        TEST_ASSERT_EQUAL_HEX16_ARRAY(ref, dst, PIE_SIZE);
+    }
+}
+
+void app_main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(TestCopyPie);
+    RUN_TEST(TestSwapCopyPie);
+    RUN_TEST(TestFillPie);
+    RUN_TEST(TestPixelChecks);
+    UNITY_END();
+}